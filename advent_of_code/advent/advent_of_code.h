@@ -1,6 +1,48 @@
 #pragma once
 
+#include <string>
 #include <string_view>
 #include <vector>
+#include <optional>
+#include <cstddef>
 
-bool verify_all(const std::vector<std::string_view>& filters);
\ No newline at end of file
+enum class output_format : char
+{
+	human,
+	json,
+	csv
+};
+
+// Settings for a run of verify_all. Set from the command line with arguments starting "--".
+struct verify_options
+{
+	// Number of timed runs of each test. More than one puts verify_all into benchmark mode.
+	std::size_t repetitions = 1;
+
+	// Number of untimed runs of each test before the timed ones. Defaults to one in benchmark mode.
+	std::optional<std::size_t> warmup;
+
+	std::size_t get_warmup() const { return warmup.value_or(repetitions > 1 ? 1 : 0); }
+
+	// Number of threads to run tests on. Zero uses every core.
+	std::size_t num_threads = 1;
+
+	// For json and csv, the report goes to output_file (or std::cout if empty) and everything else goes to std::cerr.
+	output_format format = output_format::human;
+	std::string output_file;
+
+	// A csv report from an earlier run. Each test's time is compared against it, and verify_all fails
+	// if any test is slower by more than threshold_percent (and by more than the noise in either run).
+	std::string baseline_file;
+	std::size_t threshold_percent = 10;
+
+	// Count instructions, cycles, cache misses, branch mispredicts and page faults for each test.
+	bool collect_perf_counters = false;
+};
+
+// Returns false if the argument is not a recognised option.
+bool parse_option(verify_options& options, std::string_view arg);
+void print_options_help();
+
+bool verify_all(const std::vector<std::string_view>& filters);
+bool verify_all(const std::vector<std::string_view>& filters, const verify_options& options);
\ No newline at end of file
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace advent
+{
+	enum class perf_counter : char
+	{
+		instructions,
+		cycles,
+		cache_misses,
+		branch_misses,
+		page_faults
+	};
+
+	constexpr std::size_t NUM_PERF_COUNTERS = 5;
+
+	constexpr std::array<perf_counter, NUM_PERF_COUNTERS> ALL_PERF_COUNTERS
+	{
+		perf_counter::instructions,
+		perf_counter::cycles,
+		perf_counter::cache_misses,
+		perf_counter::branch_misses,
+		perf_counter::page_faults
+	};
+
+	const char* to_string(perf_counter counter);
+
+	// Counts for one measured section. A counter the platform can't provide is left empty.
+	struct perf_counts
+	{
+		std::array<std::optional<uint64_t>, NUM_PERF_COUNTERS> counts;
+
+		std::optional<uint64_t>& operator[](perf_counter counter) { return counts[static_cast<std::size_t>(counter)]; }
+		const std::optional<uint64_t>& operator[](perf_counter counter) const { return counts[static_cast<std::size_t>(counter)]; }
+		bool empty() const;
+		perf_counts& operator+=(const perf_counts& other);
+		perf_counts& operator/=(uint64_t divisor);
+	};
+
+	std::string to_string(const perf_counts& counts);
+
+	// Counts hardware events on the calling thread, and on any threads it starts, between start() and stop().
+	// Uses perf_event_open on Linux. The counters are opened as a single group, so they're always scheduled together
+	// and ratios between them (like instructions per cycle) come from the same stretch of time.
+	// Elsewhere, or if the kernel refuses (e.g. perf_event_paranoid is too high or we're in a VM without a PMU),
+	// the affected counters are simply missing from the results.
+	class perf_counter_group
+	{
+	public:
+		// Time enabled, time running, then each open counter's value.
+		using reading = std::array<uint64_t, NUM_PERF_COUNTERS + 2>;
+	private:
+		std::array<int, NUM_PERF_COUNTERS> m_fds;
+		std::optional<reading> m_start_reading;
+		int get_leader_fd() const;
+		std::size_t get_num_open() const;
+	public:
+		perf_counter_group();
+		~perf_counter_group();
+		perf_counter_group(const perf_counter_group&) = delete;
+		perf_counter_group& operator=(const perf_counter_group&) = delete;
+
+		void start();
+		perf_counts stop();
+	};
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <chrono>
+#include <string_view>
+#include <vector>
+#include <utility>
+
+namespace advent
+{
+	// Time spent in each named phase of a test, in the order the phases first started.
+	using phase_times = std::vector<std::pair<std::string_view, std::chrono::nanoseconds>>;
+
+	// Times a phase of a solution (e.g. "parse" or "solve") from construction until it goes out of scope,
+	// so the test runner can report where the time went. Phases with the same name add together.
+	// The name is not copied, so use a string literal.
+	// Phases are only recorded on the thread running the test. A timer on any other thread, such as one of
+	// parallel_for's workers, silently records nothing, so put timers around a parallel_for rather than inside its tasks.
+	class phase_timer
+	{
+		std::string_view m_name;
+		std::chrono::high_resolution_clock::time_point m_start;
+	public:
+		explicit phase_timer(std::string_view name);
+		~phase_timer();
+		phase_timer(const phase_timer&) = delete;
+		phase_timer& operator=(const phase_timer&) = delete;
+	};
+
+	// Times a single call. E.g. `const Map map = advent::timed_phase("parse", [&input]() { return get_map(input); });`
+	template <typename Fn>
+	inline decltype(auto) timed_phase(std::string_view name, Fn&& fn)
+	{
+		phase_timer timer{ name };
+		return fn();
+	}
+
+	// Used by the test runner around each run of a test. Phases are recorded per thread, so tests
+	// running in parallel don't mix. Outside of a recording phase_timer does nothing.
+	void start_phase_recording();
+	phase_times stop_phase_recording();
+}
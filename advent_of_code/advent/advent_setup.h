@@ -67,11 +67,17 @@ static const verification_test tests[] =
 
 	TESTCASE(testcase_eight_a, 40),
 	TESTCASE(testcase_eight_b, 25272),
+	TESTCASE(testcase_eight_b_links, 25272),
+	TESTCASE(testcase_eight_b_boruvka, 25272),
 	DAY(eight,DAY_08_1_SOLUTION,DAY_08_2_SOLUTION),
+	TESTCASE(advent_eight_p2_links, DAY_08_2_SOLUTION),
+	TESTCASE(advent_eight_p2_boruvka, DAY_08_2_SOLUTION),
 
 	TESTCASE(testcase_nine_a, 50),
 	TESTCASE(testcase_nine_b, 24),
+	TESTCASE(testcase_nine_b_compressed_grid, 24),
 	DAY(nine,DAY_09_1_SOLUTION,DAY_09_2_SOLUTION),
+	TESTCASE(advent_nine_p2_compressed_grid, DAY_09_2_SOLUTION),
 
 	TESTCASE_WITH_ARG(testcase_ten_a, DAY_TEN[0], 2),
 	TESTCASE_WITH_ARG(testcase_ten_a, DAY_TEN[1], 3),
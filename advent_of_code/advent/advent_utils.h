@@ -7,11 +7,15 @@
 #include <format>
 
 #include "advent_assert.h"
+#include "advent_phase_timer.h"
+
+#include "utils/mapped_file.h"
 
 namespace advent
 {
 	inline std::ifstream open_input(const std::string& filename)
 	{
+		phase_timer timer{ "open" };
 		auto full_path = [&filename]()
 			{
 				return (std::filesystem::current_path() / filename);
@@ -45,4 +49,32 @@ namespace advent
 		const std::string name = std::format("advent{0}/testcase_{1}.txt", day, id);
 		return open_input(name);
 	}
+
+	// Maps the whole file into memory instead of streaming it. Use with utils::string_line_range
+	// to get lines (or any other delimiter) as std::string_views into the file without any copies.
+	inline utils::mapped_file map_input(const std::string& filename)
+	{
+		phase_timer timer{ "open" };
+		if (!std::filesystem::exists(filename))
+		{
+			std::cerr << "\nERROR! File " << (std::filesystem::current_path() / filename) << " does not exist.";
+		}
+		auto result = utils::mapped_file{ filename };
+		AdventCheck(result.is_open());
+		return result;
+	}
+
+	// Maps a file with the name "adventX/adventX.txt"
+	inline utils::mapped_file map_puzzle_input(int day)
+	{
+		const std::string name = std::format("advent{0}/advent{0}.txt", day);
+		return map_input(name);
+	}
+
+	// Maps a file with the format "adventX/testcase_Y.txt"
+	inline utils::mapped_file map_testcase_input(int day, char id)
+	{
+		const std::string name = std::format("advent{0}/testcase_{1}.txt", day, id);
+		return map_input(name);
+	}
 }
\ No newline at end of file
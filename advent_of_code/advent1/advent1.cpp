@@ -100,8 +100,8 @@ namespace
 	template <AdventDay day>
 	int64_t solve_generic(std::istream& input)
 	{
-		using ILI = utils::istream_line_iterator;
-		const auto result = std::accumulate(ILI{ input }, ILI{}, std::pair<Lock, Password>{get_initial_lock(), 0}, process_line<day>);
+		const utils::buffered_istream_line_range lines{ input };
+		const auto result = std::accumulate(lines.begin(), lines.end(), std::pair<Lock, Password>{get_initial_lock(), 0}, process_line<day>);
 		log << "\nFinal state: Pos=" << result.first << " Pwd=" << result.second;
 		return result.second;
 	}
@@ -28,14 +28,15 @@ namespace
 #include "utils/dynamic_bits.h"
 #include "utils/small_vector.h"
 #include "utils/string_line_iterator.h"
-#include "utils/istream_line_iterator.h"
+#include "utils/parallel_transform_lines.h"
 #include "utils/parse_utils.h"
 #include "utils/to_value.h"
 #include "utils/int_range.h"
-#include "utils/hash.h"
 
 #include <vector>
-#include <unordered_set>
+#include <bit>
+#include <optional>
+#include <numeric>
 
 namespace
 {
@@ -44,39 +45,6 @@ namespace
 	using Buttons = utils::small_vector<Button, 16>;
 	using JoltCounters = utils::small_vector<int16_t, 16>;
 }
-	
-namespace std
-{
-	template <>
-	struct hash<JoltCounters>
-	{
-		std::size_t operator()(const JoltCounters& jc) const noexcept
-		{
-			std::size_t result = 0u;
-			
-			auto it = begin(jc);
-			while (it != end(jc))
-			{
-				std::size_t intermediate = 0u;
-				for (std::size_t i = 0u; (i < sizeof(std::size_t)) && it != end(jc); i += sizeof(JoltCounters::value_type), ++it)
-				{
-					intermediate = intermediate << ((CHAR_BIT) * sizeof(JoltCounters::value_type));
-					intermediate += *it;
-				}
-
-				if (result == 0u)
-				{
-					result = intermediate;
-				}
-				else
-				{
-					result = utils::hash_combine(result, intermediate);
-				}
-			}
-			return result;
-		}
-	};
-}
 
 namespace
 {
@@ -163,59 +131,354 @@ namespace
 	template <AdventDay DAY>
 	int64_t get_fewest_button_presses(const Machine& machine);
 
+	// Part 1 is a linear system over GF(2): pressing a button twice undoes it, so each button is pressed at most once,
+	// and the lights that change are the XOR of the buttons pressed. Elimination gives one way of pressing the buttons,
+	// plus a basis for the combinations that change nothing. There are only ever a few of those, so every combination
+	// of them gets tried.
 	template <>
 	int64_t get_fewest_button_presses<AdventDay::one>(const Machine& machine)
 	{
-		using ButtonIt = decltype(begin(machine.buttons));
-		using State = std::pair<Lights, ButtonIt>;
+		using Row = utils::dynamic_bits<64>; // Which buttons toggle a light, then whether the light needs toggling.
+		using Presses = utils::dynamic_bits<64>;
+		const std::size_t num_buttons = machine.buttons.size();
+		const std::size_t num_lights = machine.lights.size();
 
-		std::vector<State> states_to_check{ std::pair{machine.lights,begin(machine.buttons)} };
-		std::vector<State> next_states_to_check;
+		std::vector<Row> rows(num_lights);
+		for (std::size_t light : utils::int_range{ num_lights })
+		{
+			rows[light].resize(num_buttons + 1);
+			for (std::size_t button : utils::int_range{ num_buttons })
+			{
+				AdventCheck(machine.buttons[button].size() == num_lights);
+				rows[light].set_bit(button, machine.buttons[button].get_bit(light));
+			}
+			rows[light].set_bit(num_buttons, machine.lights.get_bit(light));
+		}
 
-		int64_t depth = 0;
-		while (true)
+		std::vector<std::size_t> pivot_buttons;
+		std::vector<std::size_t> free_buttons;
+		for (std::size_t button : utils::int_range{ num_buttons })
 		{
-			for (const State& state : states_to_check)
+			const std::size_t num_pivots = pivot_buttons.size();
+			const auto pivot_it = std::find_if(begin(rows) + num_pivots, end(rows), [button](const Row& row) { return row.get_bit(button); });
+			if (pivot_it == end(rows))
 			{
-				for (auto it = state.second; it != end(machine.buttons); ++it)
+				free_buttons.push_back(button);
+				continue;
+			}
+			std::swap(*pivot_it, rows[num_pivots]);
+			for (std::size_t r : utils::int_range{ num_lights })
+			{
+				if (r != num_pivots && rows[r].get_bit(button))
 				{
-					const Button& button = *it;
-					AdventCheck(button.size() == state.first.size());
-					const Lights next_lights = state.first ^ button;
-					if (next_lights.popcount() == 0u)
-					{
-						return depth + 1;
-					}
-					next_states_to_check.emplace_back(next_lights, it + 1);
+					rows[r] ^= rows[num_pivots];
 				}
 			}
+			pivot_buttons.push_back(button);
+		}
+
+		// Any rows left over have no buttons, so they had better not need toggling.
+		AdventCheck(stdr::none_of(rows | std::views::drop(pivot_buttons.size()), [num_buttons](const Row& row) { return row.get_bit(num_buttons); }));
+
+		auto make_presses = [num_buttons]()
+			{
+				Presses result;
+				result.resize(num_buttons);
+				return result;
+			};
+
+		// Leave every free button alone.
+		Presses presses = make_presses();
+		for (std::size_t r : utils::int_range{ pivot_buttons.size() })
+		{
+			presses.set_bit(pivot_buttons[r], rows[r].get_bit(num_buttons));
+		}
+
+		// Pressing one free button, and whichever pivots undo its effect.
+		std::vector<Presses> null_space;
+		null_space.reserve(free_buttons.size());
+		for (std::size_t free_button : free_buttons)
+		{
+			Presses& basis = null_space.emplace_back(make_presses());
+			basis.set_bit(free_button, true);
+			for (std::size_t r : utils::int_range{ pivot_buttons.size() })
+			{
+				basis.set_bit(pivot_buttons[r], rows[r].get_bit(free_button));
+			}
+		}
 
-			states_to_check.swap(next_states_to_check);
-			next_states_to_check.clear();
-			++depth;
+		// Walk a Gray code so each step flips exactly one basis vector.
+		AdventCheck(null_space.size() < 64u);
+		std::size_t fewest = presses.popcount();
+		for (uint64_t step = 1; step < (uint64_t{ 1 } << null_space.size()); ++step)
+		{
+			presses ^= null_space[std::countr_zero(step)];
+			fewest = std::min(fewest, presses.popcount());
 		}
-		AdventUnreachable();
-		return 0;
+		return static_cast<int64_t>(fewest);
+	}
+
+	// Part 2 is an integer linear program: find non-negative press counts x such that, for every counter,
+	// the presses of the buttons wired to it add up to its target, with the fewest presses in total.
+	// Integer Gaussian elimination leaves every button either a pivot, which follows from the others, or free.
+	// There are only ever a few free buttons, so those get enumerated.
+	using Row = utils::small_vector<int64_t, 16>; // A coefficient per button, then the target.
+
+	struct ButtonSystem
+	{
+		// Each row has a positive coefficient for its pivot button, and every other row has zero for that button.
+		std::vector<Row> rows;
+		std::vector<std::size_t> pivot_buttons; // One per row.
+		std::vector<std::size_t> free_buttons;
+		std::vector<int64_t> max_presses; // Per button. Pressing it more would overshoot a counter.
+	};
+
+	// Rounds towards negative infinity, unlike the / operator.
+	int64_t divide_floor(int64_t numerator, int64_t denominator)
+	{
+		AdventCheck(denominator > 0);
+		const int64_t quotient = numerator / denominator;
+		return (numerator % denominator < 0) ? quotient - 1 : quotient;
+	}
+
+	int64_t divide_ceil(int64_t numerator, int64_t denominator)
+	{
+		return -divide_floor(-numerator, denominator);
 	}
 
-	JoltCounters press_button(JoltCounters counters, Button button)
+	// Keeps the numbers small, since eliminating without fractions multiplies rows together.
+	void reduce_row(Row& row)
 	{
-		for (auto idx : utils::int_range{ button.size() })
+		const int64_t divisor = stdr::fold_left(row, int64_t{ 0 }, [](int64_t a, int64_t b) { return std::gcd(a, b); });
+		if (divisor > 1)
 		{
-			AdventCheck(idx < counters.size());
-			if (button.get_bit(idx))
+			stdr::for_each(row, [divisor](int64_t& value) { value /= divisor; });
+		}
+	}
+
+	ButtonSystem eliminate(const Machine& machine)
+	{
+		const std::size_t num_buttons = machine.buttons.size();
+		const std::size_t num_counters = machine.joltCounters.size();
+		ButtonSystem result;
+		result.rows.resize(num_counters);
+		result.max_presses.resize(num_buttons, std::numeric_limits<int64_t>::max());
+		for (std::size_t counter : utils::int_range{ num_counters })
+		{
+			Row& row = result.rows[counter];
+			row.reserve(num_buttons + 1);
+			for (std::size_t button : utils::int_range{ num_buttons })
+			{
+				AdventCheck(machine.buttons[button].size() == num_counters);
+				const bool wired = machine.buttons[button].get_bit(counter);
+				row.push_back(wired ? 1 : 0);
+				if (wired)
+				{
+					result.max_presses[button] = std::min<int64_t>(result.max_presses[button], machine.joltCounters[counter]);
+				}
+			}
+			row.push_back(machine.joltCounters[counter]);
+		}
+		// A button with no counters does nothing, so it's never worth pressing.
+		stdr::replace(result.max_presses, std::numeric_limits<int64_t>::max(), int64_t{ 0 });
+
+		std::size_t num_pivots = 0;
+		for (std::size_t button : utils::int_range{ num_buttons })
+		{
+			auto candidates = std::views::iota(num_pivots, num_counters)
+				| std::views::filter([&rows = result.rows, button](std::size_t r) { return rows[r][button] != 0; });
+			const auto pivot_it = stdr::min_element(candidates, {}, [&rows = result.rows, button](std::size_t r) { return std::abs(rows[r][button]); });
+			if (pivot_it == stdr::end(candidates))
+			{
+				result.free_buttons.push_back(button);
+				continue;
+			}
+
+			std::swap(result.rows[*pivot_it], result.rows[num_pivots]);
+			Row& pivot_row = result.rows[num_pivots];
+			if (pivot_row[button] < 0)
+			{
+				stdr::for_each(pivot_row, [](int64_t& value) { value = -value; });
+			}
+
+			for (std::size_t r : utils::int_range{ num_counters })
 			{
-				--counters[idx];
+				Row& row = result.rows[r];
+				if (r == num_pivots || row[button] == 0) continue;
+				const int64_t pivot_value = pivot_row[button];
+				const int64_t factor = row[button];
+				for (std::size_t i : utils::int_range{ row.size() })
+				{
+					row[i] = row[i] * pivot_value - pivot_row[i] * factor;
+				}
+				reduce_row(row);
 			}
+			result.pivot_buttons.push_back(button);
+			++num_pivots;
 		}
-		return counters;
+
+		// Whatever is left over is all zeroes, or the machine can't be solved at all.
+		AdventCheck(stdr::all_of(result.rows | std::views::drop(num_pivots), [](const Row& row) { return row.back() == 0; }));
+		result.rows.resize(num_pivots);
+		return result;
 	}
 
+	// Tries every combination of free button presses. Each pivot's presses must come out as a whole number in range,
+	// so each row narrows down the presses for the free button being picked, using the range the remaining free
+	// buttons could still contribute.
+	class PressSearch
+	{
+		const ButtonSystem& m_system;
+		Row m_remaining; // Per row: the target minus what the free buttons picked so far contribute.
+		std::vector<Row> m_min_rest; // [free index][row]: the least that free buttons from here onwards could contribute.
+		std::vector<Row> m_max_rest;
+
+		// Once the pivots are substituted, the total presses are linear in the free buttons:
+		// the free presses, plus the sum of remaining / pivot coefficient over the rows, so each free button has a weight.
+		// That gives a lower bound for a partial solution, and says which end of a button's range is cheapest.
+		std::vector<double> m_weights; // Per free button.
+		std::vector<double> m_min_rest_weight; // [free index]: the most that free buttons from here onwards could save.
+		std::optional<int64_t> m_best;
+
+		int64_t coefficient(std::size_t row, std::size_t free_idx) const
+		{
+			return m_system.rows[row][m_system.free_buttons[free_idx]];
+		}
+
+		int64_t pivot_value(std::size_t row) const
+		{
+			return m_system.rows[row][m_system.pivot_buttons[row]];
+		}
+
+		int64_t max_pivot_contribution(std::size_t row) const
+		{
+			return pivot_value(row) * m_system.max_presses[m_system.pivot_buttons[row]];
+		}
+
+		void press(std::size_t free_idx, int64_t presses)
+		{
+			for (std::size_t row : utils::int_range{ m_system.rows.size() })
+			{
+				m_remaining[row] -= coefficient(row, free_idx) * presses;
+			}
+		}
+
+		bool can_beat_best(double lower_bound) const
+		{
+			constexpr double TOLERANCE = 1e-6;
+			return !m_best.has_value() || lower_bound < static_cast<double>(*m_best) - 1.0 + TOLERANCE;
+		}
+
+		void finish(int64_t free_presses)
+		{
+			int64_t total = free_presses;
+			for (std::size_t row : utils::int_range{ m_system.rows.size() })
+			{
+				if (m_remaining[row] % pivot_value(row) != 0) return;
+				const int64_t presses = m_remaining[row] / pivot_value(row);
+				if (presses < 0 || presses > m_system.max_presses[m_system.pivot_buttons[row]]) return;
+				total += presses;
+			}
+			if (!m_best.has_value() || total < *m_best)
+			{
+				m_best = total;
+			}
+		}
+
+		void search(std::size_t free_idx, int64_t free_presses)
+		{
+			if (free_idx == m_system.free_buttons.size())
+			{
+				finish(free_presses);
+				return;
+			}
+
+			int64_t low = 0;
+			int64_t high = m_system.max_presses[m_system.free_buttons[free_idx]];
+			for (std::size_t row : utils::int_range{ m_system.rows.size() })
+			{
+				// Need 0 <= remaining - c*presses - rest <= max pivot contribution for some rest in [min_rest, max_rest].
+				const int64_t c = coefficient(row, free_idx);
+				const int64_t most = m_remaining[row] - m_min_rest[free_idx + 1][row];
+				const int64_t least = m_remaining[row] - m_max_rest[free_idx + 1][row] - max_pivot_contribution(row);
+				if (c > 0)
+				{
+					high = std::min(high, divide_floor(most, c));
+					low = std::max(low, divide_ceil(least, c));
+				}
+				else if (c < 0)
+				{
+					low = std::max(low, divide_ceil(-most, -c));
+					high = std::min(high, divide_floor(-least, -c));
+				}
+				else if (most < 0 || least > 0)
+				{
+					return;
+				}
+			}
+
+			if (low > high) return;
+
+			double base_bound = static_cast<double>(free_presses) + m_min_rest_weight[free_idx + 1];
+			for (std::size_t row : utils::int_range{ m_system.rows.size() })
+			{
+				base_bound += static_cast<double>(m_remaining[row]) / static_cast<double>(pivot_value(row));
+			}
+
+			// Go from the cheapest end, so the first bad bound means the rest are all worse.
+			const double weight = m_weights[free_idx];
+			const bool ascending = weight >= 0.0;
+			int64_t pressed = 0;
+			for (int64_t i = 0; i <= high - low; ++i)
+			{
+				const int64_t presses = ascending ? low + i : high - i;
+				if (!can_beat_best(base_bound + weight * static_cast<double>(presses))) break;
+				press(free_idx, presses - pressed);
+				pressed = presses;
+				search(free_idx + 1, free_presses + presses);
+			}
+			press(free_idx, -pressed);
+		}
+	public:
+		explicit PressSearch(const ButtonSystem& system) : m_system{ system }
+		{
+			const std::size_t num_rows = system.rows.size();
+			const std::size_t num_free = system.free_buttons.size();
+			for (const Row& row : system.rows)
+			{
+				m_remaining.push_back(row.back());
+			}
+			m_min_rest.assign(num_free + 1, Row(num_rows, int64_t{ 0 }));
+			m_max_rest.assign(num_free + 1, Row(num_rows, int64_t{ 0 }));
+			m_weights.assign(num_free, 1.0);
+			m_min_rest_weight.assign(num_free + 1, 0.0);
+			for (std::size_t free_idx = num_free; free_idx-- > 0;)
+			{
+				const int64_t max_presses = system.max_presses[system.free_buttons[free_idx]];
+				for (std::size_t row : utils::int_range{ num_rows })
+				{
+					const int64_t most = coefficient(row, free_idx) * max_presses;
+					m_min_rest[free_idx][row] = m_min_rest[free_idx + 1][row] + std::min<int64_t>(most, 0);
+					m_max_rest[free_idx][row] = m_max_rest[free_idx + 1][row] + std::max<int64_t>(most, 0);
+					m_weights[free_idx] -= static_cast<double>(coefficient(row, free_idx)) / static_cast<double>(pivot_value(row));
+				}
+				m_min_rest_weight[free_idx] = m_min_rest_weight[free_idx + 1] + std::min(0.0, m_weights[free_idx] * static_cast<double>(max_presses));
+			}
+		}
+
+		int64_t run()
+		{
+			search(0, 0);
+			AdventCheck(m_best.has_value());
+			return *m_best;
+		}
+	};
+
 	template <>
 	int64_t get_fewest_button_presses<AdventDay::two>(const Machine& machine)
 	{
-		// TODO
-		return 0;
+		const ButtonSystem system = eliminate(machine);
+		return PressSearch{ system }.run();
 	}
 
 	template <AdventDay day>
@@ -228,7 +491,7 @@ namespace
 	template <AdventDay day>
 	int64_t solve(std::istream& input)
 	{
-		return stdr::fold_left(utils::istream_line_range{ input } | std::views::transform(solve_line<day>), int64_t{ 0 }, std::plus<int64_t>{});
+		return utils::parallel_transform_reduce_lines(input, int64_t{ 0 }, solve_line<day>);
 	}
 }
 
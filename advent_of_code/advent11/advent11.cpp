@@ -31,124 +31,166 @@ namespace
 #include "utils/istream_line_iterator.h"
 #include "utils/int_range.h"
 
-#include <map>
+#include <vector>
+#include <span>
+#include <optional>
+#include <numeric>
+#include <limits>
 
 namespace
 {
-	using Node = uint32_t;
-	using OutputList = utils::small_vector<Node, 4>;
-	using Device = std::pair<const Node, OutputList>;
-	using Graph = std::map<Node, OutputList>;
-	static_assert(std::is_same_v<Device, Graph::value_type>);
+	using Label = uint32_t; // Up to four characters packed together.
+	using Node = uint32_t; // Dense ids from 0 to the number of devices.
 
-	Node parse_node(std::string_view label)
+	Label parse_label(std::string_view label)
 	{
 		AdventCheck(label.size() <= 4u);
-		Node result = 0u;
+		Label result = 0u;
 		std::memcpy(&result, label.data(), label.size());
 		return result;
 	}
 
-	Device parse_device(std::string_view line)
+	// Every label gets interned to a dense id, and the outputs are stored in compressed sparse row form:
+	// the outputs of node n are m_outputs[m_offsets[n]] up to m_outputs[m_offsets[n+1]].
+	// So following an edge, or looking up a memo, is just indexing into an array.
+	class Graph
 	{
-		auto [label, output_labels_str] = utils::split_string_at_first(line, ':');
-		label = utils::trim_string(label);
-		output_labels_str = utils::trim_string(output_labels_str);
-		const Node node = parse_node(label);
-		const auto output_range = utils::string_line_range{ output_labels_str, ' '};
-		const auto num_outputs = stdr::count(output_labels_str, ' ') + 1;
-		OutputList outputs;
-		outputs.reserve(num_outputs);
-		stdr::transform(output_range, std::back_inserter(outputs), parse_node);
-		return std::pair{ node, std::move(outputs) };
-	}
+		std::vector<Label> m_labels; // Sorted, so the index of a label is its id.
+		std::vector<uint32_t> m_offsets;
+		std::vector<Node> m_outputs;
+	public:
+		explicit Graph(std::istream& input)
+		{
+			std::vector<std::pair<Label, Label>> links;
+			for (std::string_view line : utils::buffered_istream_line_range{ input })
+			{
+				if (line.empty()) continue;
+				auto [label, output_labels_str] = utils::split_string_at_first(line, ':');
+				const Label from = parse_label(utils::trim_string(label));
+				m_labels.push_back(from);
+				for (std::string_view output_label : utils::string_line_range{ utils::trim_string(output_labels_str), ' ' })
+				{
+					links.emplace_back(from, parse_label(output_label));
+					m_labels.push_back(links.back().second);
+				}
+			}
 
-	Graph parse_graph(std::istream& input)
-	{
-		Graph result;
-		stdr::transform(utils::istream_line_range{ input }, std::inserter(result,result.begin()), parse_device);
-		return result;
-	}
+			stdr::sort(m_labels);
+			const auto [unique_end, labels_end] = stdr::unique(m_labels);
+			m_labels.erase(unique_end, labels_end);
+			AdventCheck(m_labels.size() < std::numeric_limits<Node>::max());
 
-	using Memo = std::map<Node, int64_t>;
+			// Count each node's outputs, turn the counts into offsets, then fill in the outputs in input order.
+			m_offsets.assign(m_labels.size() + 1, 0u);
+			for (const auto& [from, to] : links)
+			{
+				++m_offsets[*find(from) + 1];
+			}
+			std::partial_sum(begin(m_offsets), end(m_offsets), begin(m_offsets));
+			m_outputs.resize(links.size());
+			std::vector<uint32_t> next_output{ begin(m_offsets), end(m_offsets) - 1 };
+			for (const auto& [from, to] : links)
+			{
+				m_outputs[next_output[*find(from)]++] = *find(to);
+			}
+		}
 
-	int64_t get_num_paths_impl(Memo& memo, const Graph& graph, Node from, Node to, const utils::small_vector<Node, 2>& forbidden_targets)
-	{
-		// First check if we are at out destination.
-		if (from == to) return 1;
+		std::optional<Node> find(Label label) const
+		{
+			const auto it = stdr::lower_bound(m_labels, label);
+			if (it == end(m_labels) || *it != label) return std::nullopt;
+			return static_cast<Node>(std::distance(begin(m_labels), it));
+		}
 
-		// Check if we can find this in the memo. Use lower_bound so we have
-		// an insert hint to use later, if necessary.
-		const auto memo_find_result = memo.lower_bound(from);
-		if (memo_find_result != end(memo) && memo_find_result->first == from)
+		std::optional<Node> find(std::string_view label) const { return find(parse_label(label)); }
+
+		std::span<const Node> get_outputs(Node node) const
 		{
-			return memo_find_result->second;
+			return std::span{ m_outputs }.subspan(m_offsets[node], m_offsets[node + 1] - m_offsets[node]);
 		}
 
-		// It wasn't in the memo, so find the list of next nodes in the graph.
-		const auto device_it = graph.find(from);
-		if (device_it == end(graph)) return 0;
+		std::size_t size() const { return m_labels.size(); }
+
+		// Kahn's algorithm: a node goes in once every node leading to it has. The devices have to form a DAG,
+		// or there would be infinitely many paths.
+		std::vector<Node> get_topological_order() const
+		{
+			std::vector<uint32_t> num_inputs(size(), 0u);
+			for (Node output : m_outputs)
+			{
+				++num_inputs[output];
+			}
 
-		// Add up all the routes.
-		auto impl = [&memo, &graph, from, to, &forbidden_targets](Node next_from) -> int64_t
+			std::vector<Node> result;
+			result.reserve(size());
+			for (Node node : utils::int_range{ static_cast<Node>(size()) })
 			{
-				if (next_from != to && stdr::contains(forbidden_targets, next_from))
+				if (num_inputs[node] == 0u)
 				{
-					return 0;
+					result.push_back(node);
 				}
-				return get_num_paths_impl(memo, graph, next_from, to, forbidden_targets);
-			};
-
-		const auto result = stdr::fold_left(device_it->second | std::views::transform(impl), int64_t{0}, std::plus<int64_t>{});
-		
-		// Add the result to the memo.
-		memo.insert(memo_find_result, std::pair{ from, result });
-		return result;
-	}
+			}
+			for (std::size_t i = 0; i < result.size(); ++i)
+			{
+				for (Node output : get_outputs(result[i]))
+				{
+					if (--num_inputs[output] == 0u)
+					{
+						result.push_back(output);
+					}
+				}
+			}
+			AdventCheck(result.size() == size());
+			return result;
+		}
+	};
 
-	int64_t get_num_paths_impl(const Graph& graph, Node from, Node to)
+	Graph parse_graph(std::istream& input)
 	{
-		AdventCheck(graph.contains(from));
-		Memo memo;
-		return get_num_paths_impl(memo, graph, from, to, {});
+		advent::phase_timer timer{ "parse" };
+		return Graph{ input };
 	}
 
-	int64_t get_num_paths(std::istream& graph_stream, std::string_view from_label, std::string_view to_label, utils::small_vector<std::string_view, 2> extra_target_labels = {})
+	// Counts the paths from `from` to `to` that visit every waypoint, in one sweep through the nodes in topological order.
+	// Each node has a count of the paths reaching it for every set of waypoints visited on the way (as a bitmask),
+	// so the order the waypoints get visited in never has to be tried out.
+	int64_t get_num_paths(std::istream& graph_stream, std::string_view from_label, std::string_view to_label, utils::small_vector<std::string_view, 2> waypoint_labels = {})
 	{
 		const Graph graph = parse_graph(graph_stream);
-		const Node from = parse_node(from_label);
-		const Node to = parse_node(to_label);
-		if (extra_target_labels.empty())
+		advent::phase_timer timer{ "solve" };
+		const std::optional<Node> from = graph.find(from_label);
+		const std::optional<Node> to = graph.find(to_label);
+		AdventCheck(from.has_value());
+		if (!to.has_value()) return 0;
+
+		AdventCheck(waypoint_labels.size() < 16u);
+		std::vector<uint16_t> waypoint_bits(graph.size(), 0u);
+		for (std::size_t i : utils::int_range{ waypoint_labels.size() })
 		{
-			return get_num_paths_impl(graph, from, to);
+			const std::optional<Node> waypoint = graph.find(waypoint_labels[i]);
+			if (!waypoint.has_value()) return 0;
+			waypoint_bits[*waypoint] |= static_cast<uint16_t>(1u << i);
 		}
 
-		utils::small_vector<Node, 2> extra_targets;
-		stdr::transform(extra_target_labels, std::back_inserter(extra_targets), parse_node);
-		stdr::sort(extra_targets);
+		// num_paths[node * num_masks + mask] is the number of paths from `from` to node that visited the waypoints in mask.
+		const std::size_t num_masks = std::size_t{ 1 } << waypoint_labels.size();
+		std::vector<int64_t> num_paths(graph.size() * num_masks, 0);
+		num_paths[*from * num_masks + waypoint_bits[*from]] = 1;
 
-		std::map<Node, Memo> memos_per_target;
-
-		auto get_steps = [&memos_per_target, &graph, &extra_targets](std::tuple<Node,Node> path)
-			{
-				const Node from = std::get<0>(path);
-				const Node to = std::get<1>(path);
-				Memo& memo = memos_per_target[to];
-				return get_num_paths_impl(memo, graph, from, to, extra_targets);
-			};
-
-		int64_t total = 0u;
-
-		// Each permutation of extra_targets represents a possible route.
-		do
+		for (Node node : graph.get_topological_order())
 		{
-			const int64_t first_step = get_steps({ from, extra_targets.front() });
-			const int64_t last_step = get_steps({ extra_targets.back(), to });
-			const int64_t subtotal = stdr::fold_left(extra_targets | std::views::adjacent<2> | stdr::views::transform(get_steps), first_step * last_step, std::multiplies<int64_t>{});
-			total += subtotal;
-
-		} while (stdr::next_permutation(extra_targets).found);
-		return total;
+			const int64_t* node_paths = num_paths.data() + node * num_masks;
+			if (std::all_of(node_paths, node_paths + num_masks, [](int64_t n) { return n == 0; })) continue;
+			for (Node output : graph.get_outputs(node))
+			{
+				int64_t* output_paths = num_paths.data() + output * num_masks;
+				for (std::size_t mask : utils::int_range{ num_masks })
+				{
+					output_paths[mask | waypoint_bits[output]] += node_paths[mask];
+				}
+			}
+		}
+		return num_paths[*to * num_masks + num_masks - 1];
 	}
 
 	int64_t solve_p1(std::istream& input)
@@ -226,7 +226,7 @@ namespace
 	template <AdventDay day>
 	uint64_t solve_generic(std::istream& input)
 	{
-		auto fragments = std::views::transform(utils::istream_line_range{ input , ','}, solve_fragment<day>);
+		auto fragments = std::views::transform(utils::buffered_istream_line_range{ input , ','}, solve_fragment<day>);
 		auto result = std::ranges::fold_left_first(std::move(fragments), std::plus<uint64_t>{});
 		AdventCheck(result.has_value());
 		return *result;
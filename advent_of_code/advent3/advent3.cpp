@@ -29,7 +29,7 @@ namespace
 #include <ranges>
 #include <numeric>
 
-#include "utils/istream_line_iterator.h"
+#include "utils/parallel_transform_lines.h"
 #include "utils/to_value.h"
 
 namespace
@@ -67,9 +67,7 @@ namespace
 	template <int NUM_BATTERIES>
 	uint64_t solve_generic(std::istream& input)
 	{
-		const auto result = std::ranges::fold_left_first(utils::istream_line_range{ input } | std::views::transform(get_maximum_joltage<NUM_BATTERIES>), std::plus<uint64_t>{});
-		AdventCheck(result.has_value());
-		return *result;
+		return utils::parallel_transform_reduce_lines(input, uint64_t{ 0 }, get_maximum_joltage<NUM_BATTERIES>);
 	}
 }
 
@@ -26,6 +26,8 @@ namespace
 }
 
 #include <algorithm>
+#include <vector>
+#include <cstdint>
 #include "utils/grid.h"
 
 namespace
@@ -55,6 +57,7 @@ namespace
 
 	Map get_map(std::istream& input)
 	{
+		advent::phase_timer timer{ "parse" };
 		const Map result = utils::grid_helpers::build(input);
 		AdventCheck(stdr::all_of(get_map_coords_range(result),
 			is_valid_map_node,
@@ -88,37 +91,73 @@ namespace
 
 	int64_t solve_p1(std::istream& input)
 	{
-		return get_accessible_coordinate_count(get_map(input));
+		const Map map = get_map(input);
+		advent::phase_timer timer{ "solve" };
+		return get_accessible_coordinate_count(map);
 	}
 }
 
 namespace
 {
-	int64_t solve_p2(std::istream& input)
+	using NeighbourCounts = utils::grid<int8_t>;
+
+	NeighbourCounts get_neighbour_counts(const Map& map)
 	{
-		Map map = get_map(input);
+		NeighbourCounts result;
+		result.resize(map.get_max_point(), int8_t{ 0 });
+		for (const utils::coords& loc : get_map_coords_range(map))
+		{
+			if (!has_stack(map, loc)) continue;
+			auto has_stack_pred = [&map](const utils::coords& nloc) {return has_stack(map, nloc); };
+			result[loc] = static_cast<int8_t>(stdr::count_if(loc.neighbours_plus_diag(), has_stack_pred));
+		}
+		return result;
+	}
 
-		auto get_accessible_stacks_predicate = [&map](const utils::coords& loc)
+	// Peels stacks off like a k-core: every accessible stack goes on the worklist once, and removing one
+	// only has to update its own neighbours, rather than rescanning the whole map until nothing changes.
+	int64_t count_removable_stacks(Map& map)
+	{
+		NeighbourCounts counts = get_neighbour_counts(map);
+		std::vector<utils::coords> worklist;
+		for (const utils::coords& loc : get_map_coords_range(map))
+		{
+			if (has_stack(map, loc) && counts[loc] < INACCESSIBLE_THRESHOLD)
 			{
-				return is_accessible_stack(map, loc);
-			};
+				worklist.push_back(loc);
+			}
+		}
 
-		auto coords_range = get_map_coords_range(map);
+		// Stacks are marked as removed when they go on the worklist, so nothing gets queued twice.
+		for (const utils::coords& loc : worklist)
+		{
+			map[loc] = SPACE;
+		}
 		int64_t num_removed = 0;
-
-		while (true)
+		while (!worklist.empty())
 		{
-			bool stack_removed = false;
-			for (const utils::coords& loc : coords_range | std::views::filter(get_accessible_stacks_predicate))
+			const utils::coords loc = worklist.back();
+			worklist.pop_back();
+			++num_removed;
+			for (const utils::coords& nloc : loc.neighbours_plus_diag())
 			{
-				map[loc] = SPACE;
-				++num_removed;
-				stack_removed = true;
+				if (!has_stack(map, nloc)) continue;
+				if (--counts[nloc] == INACCESSIBLE_THRESHOLD - 1)
+				{
+					map[nloc] = SPACE;
+					worklist.push_back(nloc);
+				}
 			}
-			if (!stack_removed) break;
 		}
 		return num_removed;
 	}
+
+	int64_t solve_p2(std::istream& input)
+	{
+		Map map = get_map(input);
+		advent::phase_timer timer{ "solve" };
+		return count_removable_stacks(map);
+	}
 }
 
 namespace
@@ -28,110 +28,73 @@ namespace
 #include <utility>
 #include <algorithm>
 #include <vector>
+#include <string>
+#include <sstream>
 
 #include "utils/to_value.h"
-#include "utils/split_string.h"
-#include "utils/istream_line_iterator.h"
-#include "utils/int_range.h"
-#include "utils/swap_remove.h"
-#include "utils/range_contains.h"
+#include "utils/interval_set.h"
+#include "utils/interval_lookup.h"
 
 namespace
 {
 	using ID = uint64_t;
-	using Range = std::pair<ID, ID>;
-	using RangeSet = std::vector<Range>;
+	using RangeSet = utils::interval_set<ID>;
 
-	ID parse_id(std::string_view input)
-	{
-		return utils::to_value<ID>(input);
-	}
-
-	Range parse_range(std::string_view input)
-	{
-		const auto [low_str, high_str] = utils::split_string_at_first(input, '-');
-		const ID low = parse_id(low_str);
-		const ID high = parse_id(high_str);
-		AdventCheck(low <= high);
-		return Range{ low,high+1 };
-	}
-
-	bool ranges_overlap(const Range& a, const Range& b)
+	RangeSet parse_ranges(std::istream& input)
 	{
-		if (a.first > b.second) return false;
-		if (a.second < b.first) return false;
-		return true;
-	}
+		advent::phase_timer timer{ "parse" };
 
-	void add_range(RangeSet& range_set, Range new_range)
-	{
-		// Iterate all current ranges and eat any ranges we overlap with.
-		for (auto it=begin(range_set);it!=end(range_set);/*I control this*/)
+		// Gather the whole section first so the numbers can be parsed in bulk.
+		std::string section;
+		std::string line;
+		while (std::getline(input, line) && !line.empty())
 		{
-			if (ranges_overlap(*it, new_range))
-			{
-				const bool is_last = std::distance(it, end(range_set)) == 1;
-				new_range.first = std::min(new_range.first, it->first);
-				new_range.second = std::max(new_range.second, it->second);
-				utils::swap_remove(range_set, it);
-				if (is_last) break;
-			}
-			else
-			{
-				++it;
-			}
+			section.append(line);
+			section.push_back('\n');
 		}
 
-		range_set.push_back(new_range);
-	}
-
-	RangeSet parse_ranges(std::istream& input)
-	{
-		std::string line;
+		const std::vector<ID> bounds = utils::to_values<ID>(section, "-");
+		AdventCheck(bounds.size() % 2 == 0);
 		RangeSet result;
-		while (true)
+		result.reserve(bounds.size() / 2);
+		for (std::size_t i = 0; i < bounds.size(); i += 2)
 		{
-			std::getline(input, line);
-			if (line.empty()) break;
-			add_range(result, parse_range(line));
+			AdventCheck(bounds[i] <= bounds[i + 1]);
+			result.insert(bounds[i], bounds[i + 1] + 1);
 		}
 		return result;
 	}
 
-	bool is_fresh(const RangeSet& fresh_ranges, ID id)
+	std::vector<ID> parse_ids(std::istream& input)
 	{
-		const auto matching_it = stdr::find_if(fresh_ranges, [id](const Range& r) {return utils::range_contains_exc(id, r); });
-		return matching_it != end(fresh_ranges);
+		advent::phase_timer timer{ "parse" };
+		std::ostringstream rest;
+		rest << input.rdbuf();
+		return utils::to_values<ID>(std::move(rest).str(), "");
 	}
 
-	std::size_t count_fresh(const RangeSet& fresh_ranges, std::istream& input)
+	std::size_t count_fresh(const RangeSet& fresh_ranges, const std::vector<ID>& ids)
 	{
-		auto pred = [&fresh_ranges](ID id)
-			{
-				return is_fresh(fresh_ranges, id);
-			};
-
-			return stdr::count_if(utils::istream_line_range{ input }, pred, parse_id);
+		const utils::interval_lookup<ID> lookup{ fresh_ranges };
+		return lookup.count_contained(ids);
 	}
 
 	uint64_t solve_p1(std::istream& input)
 	{
 		const RangeSet fresh_ranges = parse_ranges(input);
-		return count_fresh(fresh_ranges, input);
+		const std::vector<ID> ids = parse_ids(input);
+		advent::phase_timer timer{ "solve" };
+		return count_fresh(fresh_ranges, ids);
 	}
 }
 
 namespace
 {
-	uint64_t get_range_size(const Range& r)
-	{
-		return r.second - r.first;
-	}
-
 	uint64_t solve_p2(std::istream& input)
 	{
 		const RangeSet fresh_ranges = parse_ranges(input);
-		return stdr::fold_left(fresh_ranges | stdr::views::transform(get_range_size), uint64_t{ 0 }, std::plus<uint64_t>{});
+		advent::phase_timer timer{ "solve" };
+		return fresh_ranges.total_size();
 	}
 }
 
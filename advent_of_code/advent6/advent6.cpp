@@ -162,7 +162,7 @@ namespace
 	uint64_t solve_p1(std::istream& input)
 	{
 		using namespace p1_internal;
-		const AllResults calculation_results = stdr::fold_left(utils::istream_line_range{ input }, AllResults{}, process_line);
+		const AllResults calculation_results = stdr::fold_left(utils::buffered_istream_line_range{ input }, AllResults{}, process_line);
 		const uint64_t result = sum_all_results(calculation_results);
 		return result;
 	}
@@ -277,7 +277,7 @@ namespace
 	uint64_t solve_p2(std::istream& input)
 	{
 		using namespace p2_internal;
-		const NumberColumns calculations = stdr::fold_left(utils::istream_line_range{ input }, NumberColumns{}, process_line);
+		const NumberColumns calculations = stdr::fold_left(utils::buffered_istream_line_range{ input }, NumberColumns{}, process_line);
 		AdventCheck(stdr::all_of(calculations, &Column::is_set));
 		const uint64_t result = stdr::fold_left(calculations | stdr::views::transform([](Column c) {return c.val; }), uint64_t{ 0u }, std::plus<uint64_t>{});
 		return result;;
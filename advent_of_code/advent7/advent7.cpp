@@ -77,7 +77,7 @@ namespace
 		LineData lasers = get_starting_lasers_p1(input);
 		std::size_t split_count = 0;
 		log << '\n' << get_state_as_string({}, lasers);
-		for (std::string_view line : utils::istream_line_range{ input })
+		for (std::string_view line : utils::buffered_istream_line_range{ input })
 		{
 			const LineData splitters = read_line(line, SPLITTER);
 			if (splitters.popcount() == 0u) continue;
@@ -147,7 +147,7 @@ namespace
 		TimelineCounter next_timeline;
 		next_timeline.reserve(timelines.size());
 
-		for (std::string_view line : utils::istream_line_range{ input })
+		for (std::string_view line : utils::buffered_istream_line_range{ input })
 		{
 			set_next_timeline(timelines, next_timeline, line);
 			timelines.swap(next_timeline);
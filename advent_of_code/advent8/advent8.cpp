@@ -26,14 +26,17 @@ namespace
 }
 
 #include "utils/coords3d.h"
-#include "utils/parse_utils.h"
 #include "utils/to_value.h"
-#include "utils/istream_line_iterator.h"
-#include "utils/sorted_vector.h"
+#include "utils/disjoint_set.h"
 #include "utils/int_range.h"
 #include "utils/swap_remove.h"
+#include "utils/parallel_for.h"
 
 #include <vector>
+#include <optional>
+#include <queue>
+#include <tuple>
+#include <numeric>
 
 namespace
 {
@@ -43,7 +46,6 @@ namespace
 	using CoordType = int;
 	using Junction = utils::coords3d<CoordType>;
 	using JunctionId = uint16_t;
-	using Circuit = utils::sorted_vector<JunctionId>;
 	using DistanceType = uint64_t;
 
 	class Link
@@ -60,116 +62,194 @@ namespace
 		JunctionId get_low() const { return m_low; }
 		JunctionId get_high() const { return m_high; }
 		DistanceType get_distance() const { return m_distance; }
+
+		// Shortest first, with ties broken by id the same way LinkGenerator breaks them.
+		friend auto operator<=>(const Link&, const Link&) = default;
 	};
 
-	CoordType parse_coord(std::string_view elem)
+	DistanceType get_distance(const Junction& a, const Junction& b)
 	{
-		return utils::to_value<CoordType>(elem);
+		return utils::distance(a.cast<DistanceType>(), b.cast<DistanceType>());
 	}
 
-	Junction parse_junction(std::string_view line)
+	Link make_link(const std::vector<Junction>& junctions, JunctionId a, JunctionId b)
 	{
-		const auto [x, y, z] = utils::get_string_elements(line, ',', 0, 1, 2);
-		return Junction{ parse_coord(x),parse_coord(y), parse_coord(z) };
+		const auto [low, high] = std::minmax(a, b);
+		return Link{ get_distance(junctions[low], junctions[high]), low, high };
 	}
 
-	std::vector<Junction> parse_junctions(std::istream& input)
+	std::vector<Junction> parse_junctions(std::string_view input)
 	{
+		advent::phase_timer timer{ "parse" };
+		const std::vector<CoordType> values = utils::to_values<CoordType>(input, ",");
+		AdventCheck(values.size() % 3 == 0);
 		std::vector<Junction> result;
-		result.reserve(1000);
-		stdr::transform(utils::istream_line_range{ input }, std::back_inserter(result), parse_junction);
+		result.reserve(values.size() / 3);
+		for (std::size_t i = 0; i < values.size(); i += 3)
+		{
+			result.emplace_back(values[i], values[i + 1], values[i + 2]);
+		}
 		return result;
 	}
 
-	std::vector<Link> get_all_links(const std::vector<Junction>& junctions)
+	// Another junction and how far it is from some junction. Ordered by distance then id, so no two are ever equal.
+	using Neighbour = std::pair<DistanceType, JunctionId>;
+
+	// A k-d tree over the junctions. It's stored implicitly: the middle of each range of ids splits it on x, y or z in turn.
+	class JunctionTree
 	{
-		AdventCheck(junctions.size() <= std::numeric_limits<JunctionId>::max());
-		std::vector<Link> result;
-		result.reserve(junctions.size() * junctions.size());
-		for (JunctionId low_id : utils::int_range(static_cast<JunctionId>(junctions.size())))
+		const std::vector<Junction>* m_junctions;
+		std::vector<JunctionId> m_ids;
+
+		static CoordType get_axis(const Junction& junction, int axis)
 		{
-			const auto low_junction = junctions[low_id].cast<DistanceType>();
-			for (JunctionId high_id : utils::int_range(static_cast<JunctionId>(low_id + 1), static_cast<JunctionId>(junctions.size())))
+			switch (axis)
 			{
-				const auto high_junction = junctions[high_id].cast<DistanceType>();
-				const auto distance = utils::distance(low_junction, high_junction);
-				result.emplace_back(distance, low_id, high_id);
+			case 0:
+				return junction.x;
+			case 1:
+				return junction.y;
+			default:
+				return junction.z;
 			}
 		}
-		stdr::sort(result, {}, &Link::get_distance);
-		return result;
-	}
 
-	std::vector<Link> get_all_links(std::istream& input)
-	{
-		const auto junctions = parse_junctions(input);
-		return get_all_links(junctions);
-	}
+		static int next_axis(int axis) { return (axis + 1) % 3; }
 
-	bool add_link(std::vector<Circuit>& circuits, Link link)
-	{
-		auto get_current_circuit = [&circuits](JunctionId id)
-			{
-				return stdr::find_if(circuits, [id](const Circuit& c) {return c.contains(id); });
-			};
+		const Junction& junction(JunctionId id) const { return (*m_junctions)[id]; }
 
-		auto low_it = get_current_circuit(link.get_low());
-		auto high_it = get_current_circuit(link.get_high());
-
-		const bool found_low = low_it != end(circuits);
-		const bool found_high = high_it != end(circuits);
+		void build(std::size_t first, std::size_t last, int axis)
+		{
+			if (last - first <= 1) return;
+			const std::size_t mid = first + (last - first) / 2;
+			auto by_axis = [this, axis](JunctionId a, JunctionId b) { return get_axis(junction(a), axis) < get_axis(junction(b), axis); };
+			std::nth_element(begin(m_ids) + first, begin(m_ids) + mid, begin(m_ids) + last, by_axis);
+			build(first, mid, next_axis(axis));
+			build(mid + 1, last, next_axis(axis));
+		}
 
-		if (found_low && found_high)
+		// Keeps the k nearest found so far in a max-heap, so the furthest one is at the front.
+		void search(JunctionId self, const std::optional<Neighbour>& after, std::size_t k,
+			std::size_t first, std::size_t last, int axis, std::vector<Neighbour>& heap) const
 		{
-			if (low_it == high_it)
+			if (first >= last) return;
+			const std::size_t mid = first + (last - first) / 2;
+			const JunctionId id = m_ids[mid];
+			const Junction& target = junction(self);
+			if (id != self)
 			{
-				return false;
+				const Neighbour candidate{ get_distance(target, junction(id)), id };
+				if ((!after.has_value() || candidate > *after) && (heap.size() < k || candidate < heap.front()))
+				{
+					heap.push_back(candidate);
+					stdr::push_heap(heap);
+					if (heap.size() > k)
+					{
+						stdr::pop_heap(heap);
+						heap.pop_back();
+					}
+				}
+			}
+
+			const int64_t offset = int64_t{ get_axis(target, axis) } - int64_t{ get_axis(junction(id), axis) };
+			const bool near_is_low = offset < 0;
+			search(self, after, k, near_is_low ? first : mid + 1, near_is_low ? mid : last, next_axis(axis), heap);
+			const DistanceType distance_to_split = static_cast<DistanceType>(offset * offset);
+			if (heap.size() < k || distance_to_split <= heap.front().first)
+			{
+				search(self, after, k, near_is_low ? mid + 1 : first, near_is_low ? last : mid, next_axis(axis), heap);
 			}
-			stdr::copy(*high_it, std::back_inserter(*low_it));
-			utils::swap_remove(circuits, high_it);
 		}
-		else if (found_low && !found_high)
+	public:
+		explicit JunctionTree(const std::vector<Junction>& junctions) : m_junctions{ &junctions }
 		{
-			low_it->insert_keep_sorted(link.get_high());
+			AdventCheck(junctions.size() <= std::numeric_limits<JunctionId>::max());
+			m_ids.resize(junctions.size());
+			std::iota(begin(m_ids), end(m_ids), JunctionId{ 0 });
+			build(0, m_ids.size(), 0);
 		}
-		else if (!found_low && found_high)
+
+		// The k junctions nearest to self that come after `after` (if given), nearest first.
+		std::vector<Neighbour> find_nearest(JunctionId self, const std::optional<Neighbour>& after, std::size_t k) const
+		{
+			std::vector<Neighbour> result;
+			result.reserve(k + 1);
+			search(self, after, k, 0, m_ids.size(), 0, result);
+			stdr::sort_heap(result);
+			return result;
+		}
+	};
+
+	// Hands out every link in order of increasing distance without ever holding all of them.
+	// Each junction fetches its nearest neighbours from the tree in batches, and a heap holds every junction's next
+	// nearest link. Every link turns up from both ends, so it's only handed out from its low end.
+	class LinkGenerator
+	{
+		static constexpr std::size_t MIN_BATCH_SIZE = 16;
+		struct NeighbourBatch
+		{
+			std::vector<Neighbour> neighbours;
+			std::size_t next = 0;
+			std::size_t num_fetched = 0;
+		};
+		using QueueEntry = std::tuple<DistanceType, JunctionId, JunctionId>; // Distance, owner, neighbour.
+
+		JunctionTree m_tree;
+		std::vector<NeighbourBatch> m_batches;
+		std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> m_queue;
+
+		void queue_next_neighbour(JunctionId owner)
 		{
-			high_it->insert_keep_sorted(link.get_low());
+			NeighbourBatch& batch = m_batches[owner];
+			if (batch.next == batch.neighbours.size())
+			{
+				// Fetch more each time, so a junction that needs a lot of links doesn't search the same area over and over.
+				const std::optional<Neighbour> after = batch.neighbours.empty() ? std::nullopt : std::optional{ batch.neighbours.back() };
+				batch.neighbours = m_tree.find_nearest(owner, after, std::max(MIN_BATCH_SIZE, batch.num_fetched));
+				batch.num_fetched += batch.neighbours.size();
+				batch.next = 0;
+				if (batch.neighbours.empty()) return;
+			}
+			const auto [distance, neighbour] = batch.neighbours[batch.next];
+			m_queue.emplace(distance, owner, neighbour);
 		}
-		else if (!found_low && !found_high)
+	public:
+		explicit LinkGenerator(const std::vector<Junction>& junctions)
+			: m_tree{ junctions }
+			, m_batches(junctions.size())
 		{
-			circuits.emplace_back(Circuit{ link.get_low(), link.get_high() });
+			for (JunctionId id : utils::int_range(static_cast<JunctionId>(junctions.size())))
+			{
+				queue_next_neighbour(id);
+			}
 		}
-		return true;
-	}
 
-	bool check_no_overlaps(const std::vector<Circuit>& circuits)
-	{
-		for (auto out_it = begin(circuits); out_it != end(circuits); ++out_it)
+		std::optional<Link> next()
 		{
-			const auto& outer = *out_it;
-			for (auto in_it = out_it + 1; in_it != end(circuits); ++in_it)
+			while (!m_queue.empty())
 			{
-				const auto& inner = *in_it;
-				for (JunctionId id : outer)
+				const auto [distance, owner, neighbour] = m_queue.top();
+				m_queue.pop();
+				++m_batches[owner].next;
+				queue_next_neighbour(owner);
+				if (owner < neighbour)
 				{
-					if (inner.contains(id))
-					{
-						return false;
-					}
+					return Link{ distance, owner, neighbour };
 				}
 			}
+			return std::nullopt;
 		}
-		return true;
-	}
+	};
+
+	using Circuits = utils::disjoint_set<JunctionId>;
 
-	std::vector<Circuit> build_multijunction_circuits(std::vector<Link> links_by_distance, int num_links)
+	Circuits build_multijunction_circuits(LinkGenerator& links_by_distance, std::size_t num_junctions, int num_links)
 	{
-		std::vector<Circuit> result;
+		Circuits result{ static_cast<JunctionId>(num_junctions) };
 		int links_made = 0;
-		for (Link link : links_by_distance)
+		while (const std::optional<Link> link = links_by_distance.next())
 		{
-			if (add_link(result, link) || SAME_CIRCUIT_LINKS_COUNT)
+			if (result.unite(link->get_low(), link->get_high()) || SAME_CIRCUIT_LINKS_COUNT)
 			{
 				++links_made;
 				if (links_made == num_links)
@@ -179,48 +259,195 @@ namespace
 			}
 		}
 		AdventCheck(links_made <= num_links);
-		AdventCheck(check_no_overlaps(result));
 		return result;
 	}
 
-	uint64_t get_circuit_product(const auto& circuits_sorted_by_size)
-	{
-		return stdr::fold_left(circuits_sorted_by_size | std::views::transform(&Circuit::size)
-			, std::size_t{ 1 }, std::multiplies<std::size_t>{});
-	}
-
-	uint64_t solve_p1(std::istream& input, int num_links)
+	uint64_t solve_p1(std::string_view input, int num_links)
 	{
 		constexpr int NUM_CIRCUITS_TO_MULTIPLY = 3;
-		const std::vector<Link> links = get_all_links(input);
-		std::vector<Circuit> circuits = build_multijunction_circuits(links, num_links);
-		stdr::nth_element(circuits, begin(circuits) + NUM_CIRCUITS_TO_MULTIPLY, std::greater<std::size_t>{}, & Circuit::size);
-		return get_circuit_product(circuits | std::views::take(3));
+		const std::vector<Junction> junctions = parse_junctions(input);
+		advent::phase_timer timer{ "solve" };
+		LinkGenerator links{ junctions };
+		const Circuits circuits = build_multijunction_circuits(links, junctions.size(), num_links);
+		std::vector<JunctionId> sizes = circuits.component_sizes();
+		AdventCheck(sizes.size() >= NUM_CIRCUITS_TO_MULTIPLY);
+		stdr::nth_element(sizes, begin(sizes) + NUM_CIRCUITS_TO_MULTIPLY, std::greater<JunctionId>{});
+		return stdr::fold_left(sizes | std::views::take(NUM_CIRCUITS_TO_MULTIPLY), uint64_t{ 1 }, std::multiplies<uint64_t>{});
 	}
 }
 
 namespace
 {
-	int64_t solve_p2(std::istream& input)
+	// Part 2 wants the link that finally joins every junction into one circuit. Adding links shortest first
+	// is Kruskal's algorithm, so that's the longest link in the minimum spanning tree, which can be found without
+	// going through the links in order at all. The tree is unique because no two links compare equal.
+	enum class P2Engine : char
 	{
-		const std::vector<Junction> junctions = parse_junctions(input);
-		const std::vector<Link> links = get_all_links(junctions);
-		std::vector<Circuit> circuits;
+		links,
+		prim,
+		boruvka
+	};
 
-		for (Link link : links)
+	Link get_last_link_kruskal(const std::vector<Junction>& junctions)
+	{
+		LinkGenerator links{ junctions };
+		Circuits circuits{ static_cast<JunctionId>(junctions.size()) };
+		while (const std::optional<Link> link = links.next())
 		{
-			add_link(circuits, link);
-			if (circuits.size() == 1u && circuits.front().size() == junctions.size())
+			circuits.unite(link->get_low(), link->get_high());
+			if (circuits.num_components() == 1u)
 			{
-				const Junction low = junctions[link.get_low()];
-				const Junction high = junctions[link.get_high()];
-
-				return low.x * high.x;
+				return *link;
 			}
 		}
-		
 		AdventUnreachable();
-		return 0;
+		return Link{ 0u, 0u, 1u };
+	}
+
+	// Dense Prim's algorithm: O(n^2) time but only O(n) memory. Every junction not in the tree yet keeps
+	// its shortest link to the tree. They're kept packed together with their positions, so each pass
+	// over them is a linear scan, and a whole Link only gets built when the distance could be an improvement.
+	Link get_last_link_prim(const std::vector<Junction>& junctions)
+	{
+		AdventCheck(junctions.size() >= 2u);
+		std::vector<JunctionId> outside;
+		std::vector<Junction> outside_positions;
+		std::vector<Link> shortest_links;
+		outside.reserve(junctions.size() - 1);
+		outside_positions.reserve(junctions.size() - 1);
+		shortest_links.reserve(junctions.size() - 1);
+		for (JunctionId id : utils::int_range<JunctionId>(1, static_cast<JunctionId>(junctions.size())))
+		{
+			outside.push_back(id);
+			outside_positions.push_back(junctions[id]);
+			shortest_links.push_back(make_link(junctions, 0, id));
+		}
+
+		std::optional<Link> longest;
+		std::size_t next_idx = std::distance(begin(shortest_links), stdr::min_element(shortest_links));
+		while (!outside.empty())
+		{
+			const JunctionId added = outside[next_idx];
+			const Junction added_position = outside_positions[next_idx];
+			const Link added_link = shortest_links[next_idx];
+			longest = longest.has_value() ? std::max(*longest, added_link) : added_link;
+			utils::swap_remove(outside, next_idx);
+			utils::swap_remove(outside_positions, next_idx);
+			utils::swap_remove(shortest_links, next_idx);
+
+			// Find the next junction to add in the same pass.
+			next_idx = 0;
+			for (std::size_t i = 0; i < outside.size(); ++i)
+			{
+				const DistanceType distance = get_distance(added_position, outside_positions[i]);
+				if (distance <= shortest_links[i].get_distance())
+				{
+					const Link candidate = make_link(junctions, added, outside[i]);
+					if (candidate < shortest_links[i])
+					{
+						shortest_links[i] = candidate;
+					}
+				}
+				if (shortest_links[i] < shortest_links[next_idx])
+				{
+					next_idx = i;
+				}
+			}
+		}
+		return *longest;
+	}
+
+	// Borůvka's algorithm: every circuit joins up with its nearest other circuit at once, which at least halves
+	// the number of circuits each round. Finding each junction's nearest junction in a different circuit is
+	// independent work, so it's spread over the worker threads: every core, or just this thread when tests are
+	// already running in parallel with --jobs.
+	Link get_last_link_boruvka(const std::vector<Junction>& junctions)
+	{
+		AdventCheck(junctions.size() >= 2u);
+		const JunctionId num_junctions = static_cast<JunctionId>(junctions.size());
+		Circuits circuits{ num_junctions };
+		std::vector<JunctionId> circuit_ids(num_junctions);
+		std::vector<std::optional<Link>> shortest_links(num_junctions);
+		std::optional<Link> longest;
+		const std::size_t num_threads = utils::get_num_worker_threads(0);
+
+		auto keep_shorter = [](std::optional<Link>& current, const Link& candidate)
+			{
+				if (!current.has_value() || candidate < *current)
+				{
+					current = candidate;
+				}
+			};
+
+		while (circuits.num_components() > 1u)
+		{
+			for (JunctionId id : utils::int_range(num_junctions))
+			{
+				circuit_ids[id] = circuits.find(id);
+			}
+
+			auto find_shortest_link = [&](std::size_t task_idx)
+				{
+					const JunctionId id = static_cast<JunctionId>(task_idx);
+					std::optional<Link>& shortest = shortest_links[id];
+					shortest.reset();
+					for (JunctionId other : utils::int_range(num_junctions))
+					{
+						if (circuit_ids[other] == circuit_ids[id]) continue;
+						if (shortest.has_value() && get_distance(junctions[id], junctions[other]) > shortest->get_distance()) continue;
+						keep_shorter(shortest, make_link(junctions, id, other));
+					}
+				};
+			utils::parallel_for(num_junctions, find_shortest_link, num_threads);
+
+			// Gather each circuit's shortest link into its root's slot.
+			for (JunctionId id : utils::int_range(num_junctions))
+			{
+				if (circuit_ids[id] != id && shortest_links[id].has_value())
+				{
+					keep_shorter(shortest_links[circuit_ids[id]], *shortest_links[id]);
+				}
+			}
+
+			for (JunctionId id : utils::int_range(num_junctions))
+			{
+				if (circuit_ids[id] != id) continue;
+				AdventCheck(shortest_links[id].has_value());
+				const Link& link = *shortest_links[id];
+				if (circuits.unite(link.get_low(), link.get_high()))
+				{
+					longest = longest.has_value() ? std::max(*longest, link) : link;
+				}
+			}
+		}
+		return *longest;
+	}
+
+	template <P2Engine engine>
+	int64_t solve_p2(std::string_view input)
+	{
+		const std::vector<Junction> junctions = parse_junctions(input);
+		advent::phase_timer timer{ "solve" };
+		const Link last_link = [&junctions]()
+			{
+				if constexpr (engine == P2Engine::links)
+				{
+					return get_last_link_kruskal(junctions);
+				}
+				else if constexpr (engine == P2Engine::prim)
+				{
+					return get_last_link_prim(junctions);
+				}
+				else
+				{
+					static_assert(engine == P2Engine::boruvka);
+					return get_last_link_boruvka(junctions);
+				}
+			}();
+
+		const Junction low = junctions[last_link.get_low()];
+		const Junction high = junctions[last_link.get_high()];
+		return low.x * high.x;
 	}
 }
 
@@ -251,26 +478,46 @@ namespace
 
 ResultType testcase_eight_a()
 {
-	std::istringstream input{ TESTCASE };
-	return solve_p1(input, 10);
+	return solve_p1(TESTCASE, 10);
 }
 
 ResultType testcase_eight_b()
 {
-	std::istringstream input{ TESTCASE };
-	return solve_p2(input);
+	return solve_p2<P2Engine::prim>(TESTCASE);
+}
+
+ResultType testcase_eight_b_links()
+{
+	return solve_p2<P2Engine::links>(TESTCASE);
+}
+
+ResultType testcase_eight_b_boruvka()
+{
+	return solve_p2<P2Engine::boruvka>(TESTCASE);
 }
 
 ResultType advent_eight_p1()
 {
-	auto input = advent::open_puzzle_input(8);
-	return solve_p1(input, 1000);
+	const auto input = advent::map_puzzle_input(8);
+	return solve_p1(input.view(), 1000);
 }
 
 ResultType advent_eight_p2()
 {
-	auto input = advent::open_puzzle_input(8);
-	return solve_p2(input);
+	const auto input = advent::map_puzzle_input(8);
+	return solve_p2<P2Engine::prim>(input.view());
+}
+
+ResultType advent_eight_p2_links()
+{
+	const auto input = advent::map_puzzle_input(8);
+	return solve_p2<P2Engine::links>(input.view());
+}
+
+ResultType advent_eight_p2_boruvka()
+{
+	const auto input = advent::map_puzzle_input(8);
+	return solve_p2<P2Engine::boruvka>(input.view());
 }
 
 #undef DAY8DBG
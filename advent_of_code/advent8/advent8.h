@@ -4,6 +4,10 @@
 
 ResultType testcase_eight_a();
 ResultType testcase_eight_b();
+ResultType testcase_eight_b_links();
+ResultType testcase_eight_b_boruvka();
 
 ResultType advent_eight_p1();
 ResultType advent_eight_p2();
+ResultType advent_eight_p2_links();
+ResultType advent_eight_p2_boruvka();
@@ -26,21 +26,31 @@ namespace
 }
 
 #include "utils/coords.h"
-#include "utils/istream_line_iterator.h"
+#include "utils/to_value.h"
 #include "utils/comparisons.h"
+#include "utils/grid.h"
+#include "utils/parallel_for.h"
 
 #include <vector>
 #include <algorithm>
+#include <limits>
+#include <atomic>
 
 namespace
 {
 	using Tile = utils::coords64;
 
-	std::vector<Tile> parse_tiles(std::istream& input)
+	std::vector<Tile> parse_tiles(std::string_view input)
 	{
+		advent::phase_timer timer{ "parse" };
+		const std::vector<int64_t> values = utils::to_values<int64_t>(input, ",");
+		AdventCheck(values.size() % 2 == 0);
 		std::vector<Tile> result;
-		result.reserve(500);
-		stdr::transform(utils::istream_line_range{ input }, std::back_inserter(result), Tile::from_chars);
+		result.reserve(values.size() / 2);
+		for (std::size_t i = 0; i < values.size(); i += 2)
+		{
+			result.emplace_back(values[i], values[i + 1]);
+		}
 		return result;
 	}
 
@@ -52,22 +62,94 @@ namespace
 		return result;
 	}
 
-	// Just use the dumb n^2 solution
-	int64_t solve_p1(std::istream& input)
+	// Candidates for the lower-left corner of the biggest rectangle: any tile with another tile both left of and below it
+	// can be swapped for that one to get a bigger rectangle. Sorted by increasing x, which means decreasing y.
+	std::vector<Tile> get_lower_left_staircase(std::vector<Tile> tiles)
+	{
+		stdr::sort(tiles, [](const Tile& a, const Tile& b) { return std::pair{ a.x, a.y } < std::pair{ b.x, b.y }; });
+		std::vector<Tile> result;
+		for (const Tile& tile : tiles)
+		{
+			if (result.empty() || tile.y < result.back().y)
+			{
+				result.push_back(tile);
+			}
+		}
+		return result;
+	}
+
+	// The same for upper-right corners, also sorted by increasing x and decreasing y.
+	std::vector<Tile> get_upper_right_staircase(std::vector<Tile> tiles)
 	{
-		const std::vector<Tile> point_cache = parse_tiles(input);
-		int64_t biggest_rectangle = 0u;
+		stdr::sort(tiles, [](const Tile& a, const Tile& b) { return std::pair{ a.x, a.y } > std::pair{ b.x, b.y }; });
+		std::vector<Tile> result;
+		for (const Tile& tile : tiles)
+		{
+			if (result.empty() || tile.y > result.back().y)
+			{
+				result.push_back(tile);
+			}
+		}
+		stdr::reverse(result);
+		return result;
+	}
 
-		for (auto lower_it = begin(point_cache); lower_it != end(point_cache); ++lower_it)
+	// Like get_rectangle_size_p1, but only for lower_left really being below and left of upper_right. Other pairs get a
+	// negative size. Without this a pair the wrong way round would count, and break the monotonicity used below.
+	int64_t get_corner_rectangle_size(const Tile& lower_left, const Tile& upper_right)
+	{
+		const int64_t width = upper_right.x - lower_left.x + 1;
+		const int64_t height = upper_right.y - lower_left.y + 1;
+		if (width <= 0 && height <= 0)
 		{
-			const Tile& tile = *lower_it;
-			auto rect = [&tile](const Tile& other) { return get_rectangle_size_p1(tile, other); };
-			auto biggest = [](int64_t a, int64_t b) { return std::max(a, b); };
+			return -width * height;
+		}
+		return width * height;
+	}
 
-			biggest_rectangle = stdr::fold_left(stdr::transform_view(stdr::subrange(std::next(lower_it), end(point_cache)), rect), biggest_rectangle, biggest);
+	// As the lower-left corner moves right along its staircase, its best upper-right corner never moves left.
+	// So find the best partner for the middle corner, then split both staircases there and recurse: O(n log n).
+	int64_t get_biggest_corner_rectangle(const std::vector<Tile>& lower_lefts, std::size_t low, std::size_t high,
+		const std::vector<Tile>& upper_rights, std::size_t opt_low, std::size_t opt_high)
+	{
+		if (low >= high) return 0;
+		const std::size_t mid = low + (high - low) / 2;
+		int64_t best_size = std::numeric_limits<int64_t>::min();
+		std::size_t best_idx = opt_low;
+		for (std::size_t idx = opt_low; idx <= opt_high; ++idx)
+		{
+			const int64_t size = get_corner_rectangle_size(lower_lefts[mid], upper_rights[idx]);
+			if (size > best_size)
+			{
+				best_size = size;
+				best_idx = idx;
+			}
 		}
+		const int64_t left = get_biggest_corner_rectangle(lower_lefts, low, mid, upper_rights, opt_low, best_idx);
+		const int64_t right = get_biggest_corner_rectangle(lower_lefts, mid + 1, high, upper_rights, best_idx, opt_high);
+		return std::max({ best_size, left, right });
+	}
+
+	int64_t get_biggest_lower_left_rectangle(const std::vector<Tile>& tiles)
+	{
+		const std::vector<Tile> lower_lefts = get_lower_left_staircase(tiles);
+		const std::vector<Tile> upper_rights = get_upper_right_staircase(tiles);
+		if (lower_lefts.empty() || upper_rights.empty()) return 0;
+		return get_biggest_corner_rectangle(lower_lefts, 0, lower_lefts.size(), upper_rights, 0, upper_rights.size() - 1);
+	}
+
+	// The biggest rectangle either goes from lower-left to upper-right or from upper-left to lower-right.
+	// Flipping the y axis turns the second case into the first.
+	int64_t solve_p1(std::string_view input)
+	{
+		const std::vector<Tile> tiles = parse_tiles(input);
+		advent::phase_timer timer{ "solve" };
 
-		return biggest_rectangle;
+		std::vector<Tile> flipped_tiles;
+		flipped_tiles.reserve(tiles.size());
+		stdr::transform(tiles, std::back_inserter(flipped_tiles), [](const Tile& tile) { return Tile{ tile.x, -tile.y }; });
+
+		return std::max(get_biggest_lower_left_rectangle(tiles), get_biggest_lower_left_rectangle(flipped_tiles));
 	}
 }
 
@@ -95,6 +177,113 @@ namespace
 		}
 	};
 	
+	// A merge sort tree over lines kept in major-axis order. Level k holds the lines in blocks of 2^k, each block sorted
+	// by minor axis, so any run of lines splits into O(log n) whole blocks which can each be binary searched.
+	class SublineIndex
+	{
+		struct Level
+		{
+			std::vector<Subline> by_low;
+			std::vector<int64_t> max_high; // Running maximum of high() through each block of by_low.
+			std::vector<int64_t> highs; // Each block's high()s, sorted.
+		};
+		std::vector<Level> m_levels;
+
+		static std::size_t block_size(std::size_t level) { return std::size_t{ 1 } << level; }
+
+		// Calls fn(level, first, last) on each whole block making up [first,last) until it returns false.
+		template <typename Fn>
+		void for_each_block(std::size_t first, std::size_t last, Fn fn) const
+		{
+			for (std::size_t level = 0; first < last; ++level, first >>= 1, last >>= 1)
+			{
+				if (first & 1)
+				{
+					if (!fn(m_levels[level], first << level, (first + 1) << level)) return;
+					++first;
+				}
+				if (last & 1)
+				{
+					--last;
+					if (!fn(m_levels[level], last << level, (last + 1) << level)) return;
+				}
+			}
+		}
+
+		void fill_max_high(Level& level, std::size_t size)
+		{
+			level.max_high.resize(level.by_low.size());
+			for (std::size_t i = 0; i < level.by_low.size(); ++i)
+			{
+				const bool block_start = i % size == 0;
+				level.max_high[i] = block_start ? level.by_low[i].high() : std::max(level.max_high[i - 1], level.by_low[i].high());
+			}
+		}
+	public:
+		SublineIndex() = default;
+		explicit SublineIndex(std::vector<Subline> lines)
+		{
+			if (lines.empty()) return;
+			const std::size_t num_lines = lines.size();
+
+			Level& first_level = m_levels.emplace_back();
+			first_level.by_low = std::move(lines);
+			stdr::transform(first_level.by_low, std::back_inserter(first_level.highs), &Subline::high);
+			fill_max_high(first_level, 1);
+
+			for (std::size_t level = 1; block_size(level) <= num_lines; ++level)
+			{
+				const Level& previous = m_levels.back();
+				Level next;
+				next.by_low.resize(num_lines, Subline{ 0,0 });
+				next.highs.resize(num_lines);
+				for (std::size_t start = 0; start < num_lines; start += block_size(level))
+				{
+					const std::size_t mid = std::min(start + block_size(level - 1), num_lines);
+					const std::size_t end = std::min(start + block_size(level), num_lines);
+					std::merge(begin(previous.by_low) + start, begin(previous.by_low) + mid, begin(previous.by_low) + mid, begin(previous.by_low) + end,
+						begin(next.by_low) + start, [](const Subline& a, const Subline& b) { return a.low() < b.low(); });
+					std::merge(begin(previous.highs) + start, begin(previous.highs) + mid, begin(previous.highs) + mid, begin(previous.highs) + end,
+						begin(next.highs) + start);
+				}
+				fill_max_high(next, block_size(level));
+				m_levels.push_back(std::move(next));
+			}
+		}
+
+		// Whether any line in [first,last) overlaps range.
+		bool any_intersect(std::size_t first, std::size_t last, const Subline& range) const
+		{
+			bool result = false;
+			for_each_block(first, last, [&range, &result](const Level& level, std::size_t block_first, std::size_t block_last)
+				{
+					// Of the lines starting no later than the range ends, does the furthest reaching one get to the range?
+					const auto block = stdr::subrange(begin(level.by_low) + block_first, begin(level.by_low) + block_last);
+					const auto num_starting = stdr::distance(begin(block), stdr::upper_bound(block, range.high(), {}, &Subline::low));
+					result = num_starting > 0 && level.max_high[block_first + num_starting - 1] >= range.low();
+					return !result;
+				});
+			return result;
+		}
+
+		// The number of lines in [first,last) that contain point.
+		std::size_t count_containing(std::size_t first, std::size_t last, int64_t point) const
+		{
+			std::size_t result = 0;
+			for_each_block(first, last, [point, &result](const Level& level, std::size_t block_first, std::size_t block_last)
+				{
+					// Every line ending before point also starts before it, so take those away from the ones that start in time.
+					const auto lows = stdr::subrange(begin(level.by_low) + block_first, begin(level.by_low) + block_last);
+					const auto highs = stdr::subrange(begin(level.highs) + block_first, begin(level.highs) + block_last);
+					const auto num_started = stdr::distance(begin(lows), stdr::upper_bound(lows, point, {}, &Subline::low));
+					const auto num_ended = stdr::distance(begin(highs), stdr::lower_bound(highs, point));
+					result += static_cast<std::size_t>(num_started - num_ended);
+					return true;
+				});
+			return result;
+		}
+	};
+
 	// A lookup for lines running in the direction given in the template.
 	template <utils::direction DIRECTION>
 	class ParallelLines
@@ -103,6 +292,7 @@ namespace
 		using ValueType = std::pair<int64_t, Subline>; // Major-axis location and line on that location
 		using DataType = std::vector<ValueType>;
 		DataType m_data;
+		SublineIndex m_index;
 
 		auto lower_bound(int64_t val) const
 		{
@@ -169,6 +359,15 @@ namespace
 		void finished_adding_lines()
 		{
 			stdr::sort(m_data, {}, &ValueType::first);
+			std::vector<Subline> lines;
+			lines.reserve(m_data.size());
+			stdr::transform(m_data, std::back_inserter(lines), &ValueType::second);
+			m_index = SublineIndex{ std::move(lines) };
+		}
+
+		std::size_t to_index(typename DataType::const_iterator it) const
+		{
+			return static_cast<std::size_t>(std::distance(begin(m_data), it));
 		}
 
 		bool intersects(const Tile& corner, const Tile& other_corner) const
@@ -181,39 +380,22 @@ namespace
 			minor_axis = remove_border(minor_axis);
 			const auto low_it = lower_bound(major_axis.low());
 			const auto high_it = upper_bound(major_axis.high());
-
-			auto elem_intersects = [&minor_axis](const Subline& other)
-				{
-					return minor_axis.intersects(other);
-				};
-			return stdr::any_of(stdr::subrange(low_it, high_it), elem_intersects, &DataType::value_type::second);
+			if (low_it >= high_it) return false;
+			return m_index.any_intersect(to_index(low_it), to_index(high_it), minor_axis);
 		}
 
 		bool is_inside(const Tile& tile) const
 		{
 			const auto minor_axis = get_minor(tile);
 			const auto major_axis = get_major(tile);
-			const auto search_range = [this, major_axis]()
-				{
-					const auto from_left_it = upper_bound(major_axis);
-					const auto from_right_it = lower_bound(major_axis);
-
-					const auto left_range = stdr::subrange(begin(m_data), from_left_it);
-					const auto right_range = stdr::subrange(from_right_it, end(m_data));
-
-					const auto left_dist = stdr::distance(left_range);
-					const auto right_dist = stdr::distance(right_range);
-
-					return left_dist < right_dist ? left_range : right_range;
-				}();
-
-			// Count the number of lines crossing from the edge to this point. Odd numbers are inside, even numbers are outside!
-
-			auto num_crossings = [minor_axis](const Subline& line)
-				{
-					return utils::range_contains_inc(minor_axis, line.low(), line.high());
-				};
-			const auto result = stdr::count_if(search_range, num_crossings, &ValueType::second);
+			const auto from_left_it = upper_bound(major_axis);
+			const auto from_right_it = lower_bound(major_axis);
+
+			// Count the number of lines crossing from the nearest edge to this point. Odd numbers are inside, even numbers are outside!
+			const bool search_left = to_index(from_left_it) < m_data.size() - to_index(from_right_it);
+			const std::size_t result = search_left
+				? m_index.count_containing(0, to_index(from_left_it), minor_axis)
+				: m_index.count_containing(to_index(from_right_it), m_data.size(), minor_axis);
 			const bool inside = (result % 2) == 1;
 			return inside;
 		}
@@ -245,6 +427,12 @@ namespace
 		{
 			return x_parallel_lines.is_inside(tile) && y_parallel_lines.is_inside(tile);
 		}
+
+		bool contains_rectangle(const Tile& a, const Tile& b) const
+		{
+			const Tile middle = (a + b) / 2;
+			return is_inside(middle) && !intersects(a, b);
+		}
 	};
 
 	Lines get_lines(const std::vector<Tile>& tiles)
@@ -262,44 +450,217 @@ namespace
 		return result;
 	}
 
-	int64_t get_rectangle_size_p2(int64_t threshold, const Tile& a, const Tile& b, const Lines& lines)
+	// Squashes the tiles' distinct x and y values together so the whole polygon fits in a small grid. Even indices are the
+	// tile coordinates themselves and odd indices are the gaps between neighbouring ones. Every cell outside the polygon
+	// is marked, and a 2D prefix sum over those marks says whether a rectangle holds any outside cells in O(1).
+	// The grid has O(n^2) cells, so this is for cross-checking Lines on ordinary sized inputs rather than huge ones.
+	class CompressedGrid
 	{
-		const int64_t result = get_rectangle_size_p1(a, b);
-		if (result <= threshold) return threshold;
+		std::vector<int64_t> m_xs;
+		std::vector<int64_t> m_ys;
+		std::vector<uint32_t> m_outside_prefix_sums;
+		std::size_t m_width = 0;
+		std::size_t m_height = 0;
 
-		const Tile middle = (a + b) / 2;
-		if (!lines.is_inside(middle))
+		static std::vector<int64_t> get_distinct(const std::vector<Tile>& tiles, int64_t Tile::* axis)
 		{
-			return threshold;
+			std::vector<int64_t> result;
+			result.reserve(tiles.size());
+			stdr::transform(tiles, std::back_inserter(result), [axis](const Tile& tile) { return tile.*axis; });
+			stdr::sort(result);
+			const auto [new_end, old_end] = stdr::unique(result);
+			result.erase(new_end, old_end);
+			return result;
 		}
 
-		if (lines.intersects(a, b))
+		static std::size_t compress(const std::vector<int64_t>& values, int64_t value)
 		{
-			return threshold;
+			const auto find_result = stdr::lower_bound(values, value);
+			AdventCheck(find_result != end(values) && *find_result == value);
+			return 2 * static_cast<std::size_t>(std::distance(begin(values), find_result));
 		}
 
-		return result;
-	}
+		// A gap between two neighbouring values has no tiles in it at all, so it can't make a rectangle invalid.
+		static bool has_tiles(const std::vector<int64_t>& values, std::size_t idx)
+		{
+			if (idx % 2 == 0) return true;
+			return values[idx / 2 + 1] - values[idx / 2] > 1;
+		}
 
-	int64_t solve_p2(std::istream& input)
-	{
-		const std::vector<Tile> tiles = parse_tiles(input);
-		const Lines lines = get_lines(tiles);
+		uint32_t get_prefix_sum(std::size_t x, std::size_t y) const
+		{
+			return m_outside_prefix_sums[y * (m_width + 1) + x];
+		}
+
+		// Draws the polygon's edges into a grid with a spare row and column all around, then floods in from a corner.
+		// Anything the flood reaches is outside.
+		utils::grid<char> rasterise(const std::vector<Tile>& tiles) const
+		{
+			constexpr char UNKNOWN = '.';
+			constexpr char EDGE = '#';
+			constexpr char OUTSIDE = 'o';
+
+			utils::grid<char> result;
+			result.resize(utils::coords{ static_cast<int>(m_width + 2), static_cast<int>(m_height + 2) }, UNKNOWN);
 
-		int64_t result = 0;
+			auto draw_edge = [this, &result](const Tile& from, const Tile& to)
+				{
+					const auto [x_low, x_high] = std::minmax({ compress(m_xs, from.x), compress(m_xs, to.x) });
+					const auto [y_low, y_high] = std::minmax({ compress(m_ys, from.y), compress(m_ys, to.y) });
+					for (std::size_t x = x_low; x <= x_high; ++x)
+					{
+						for (std::size_t y = y_low; y <= y_high; ++y)
+						{
+							result.at(x + 1, y + 1) = EDGE;
+						}
+					}
+				};
+			for (std::size_t i = 0; i < tiles.size(); ++i)
+			{
+				draw_edge(tiles[i], tiles[(i + 1) % tiles.size()]);
+			}
 
-		for (auto lower_it = begin(tiles); lower_it != end(tiles); ++lower_it)
+			std::vector<utils::coords> to_visit{ utils::coords{ 0,0 } };
+			result.at(0, 0) = OUTSIDE;
+			while (!to_visit.empty())
+			{
+				const utils::coords current = to_visit.back();
+				to_visit.pop_back();
+				for (const utils::coords neighbour : current.neighbours())
+				{
+					if (result.is_on_grid(neighbour) && result.at(neighbour) == UNKNOWN)
+					{
+						result.at(neighbour) = OUTSIDE;
+						to_visit.push_back(neighbour);
+					}
+				}
+			}
+			return result;
+		}
+	public:
+		explicit CompressedGrid(const std::vector<Tile>& tiles)
+			: m_xs{ get_distinct(tiles, &Tile::x) }
+			, m_ys{ get_distinct(tiles, &Tile::y) }
 		{
-			const Tile& lower = *lower_it;
-			for (auto higher_it = std::next(lower_it); higher_it != end(tiles); ++higher_it)
+			if (tiles.empty()) return;
+			m_width = 2 * m_xs.size() - 1;
+			m_height = 2 * m_ys.size() - 1;
+
+			const utils::grid<char> raster = rasterise(tiles);
+			m_outside_prefix_sums.resize((m_width + 1) * (m_height + 1), 0u);
+			for (std::size_t y = 0; y < m_height; ++y)
 			{
-				const Tile& higher = *higher_it;
-				result = get_rectangle_size_p2(result, lower, higher, lines);
+				for (std::size_t x = 0; x < m_width; ++x)
+				{
+					const bool is_outside = raster.at(x + 1, y + 1) == 'o' && has_tiles(m_xs, x) && has_tiles(m_ys, y);
+					m_outside_prefix_sums[(y + 1) * (m_width + 1) + (x + 1)] = (is_outside ? 1u : 0u)
+						+ get_prefix_sum(x, y + 1) + get_prefix_sum(x + 1, y) - get_prefix_sum(x, y);
+				}
 			}
 		}
 
+		bool contains_rectangle(const Tile& a, const Tile& b) const
+		{
+			const auto [x_low, x_high] = std::minmax({ compress(m_xs, a.x), compress(m_xs, b.x) });
+			const auto [y_low, y_high] = std::minmax({ compress(m_ys, a.y), compress(m_ys, b.y) });
+			const uint32_t num_outside = get_prefix_sum(x_high + 1, y_high + 1) - get_prefix_sum(x_low, y_high + 1)
+				- get_prefix_sum(x_high + 1, y_low) + get_prefix_sum(x_low, y_low);
+			return num_outside == 0u;
+		}
+	};
+
+	// Interchangeable ways to check a rectangle is inside the polygon. They should always agree.
+	enum class P2Engine : char
+	{
+		lines,
+		compressed_grid
+	};
+
+	struct Candidate
+	{
+		int64_t size = 0;
+		uint32_t first_idx = 0;
+		uint32_t second_idx = 0;
+	};
+
+	// One row per tile, pairing it with every later tile, ordered by the biggest rectangle the row could give.
+	std::vector<Candidate> get_rows_by_size(const std::vector<Tile>& tiles)
+	{
+		AdventCheck(tiles.size() <= std::numeric_limits<uint32_t>::max());
+		std::vector<Candidate> result;
+		result.reserve(tiles.size());
+		for (uint32_t first_idx = 0; first_idx + 1 < tiles.size(); ++first_idx)
+		{
+			Candidate row{ 0, first_idx, first_idx };
+			for (uint32_t second_idx = first_idx + 1; second_idx < tiles.size(); ++second_idx)
+			{
+				row.size = std::max(row.size, get_rectangle_size_p1(tiles[first_idx], tiles[second_idx]));
+			}
+			result.push_back(row);
+		}
+		stdr::sort(result, stdr::greater{}, &Candidate::size);
 		return result;
 	}
+
+	// Checks one row at a time, over all the worker threads. Within a row the pairs are tried biggest first, and only the ones
+	// that could still beat the best size so far (which is shared) get sorted, so memory stays linear in the number of tiles.
+	// Rows go biggest first and are dealt out round-robin, so every thread starts on the most promising rows
+	// instead of some of them starting halfway down the list.
+	template <typename Engine>
+	int64_t get_biggest_rectangle_p2(const std::vector<Tile>& tiles, const Engine& engine)
+	{
+		const std::vector<Candidate> rows = get_rows_by_size(tiles);
+		const std::size_t num_threads = utils::get_num_worker_threads(0);
+		const std::size_t rows_per_thread = (rows.size() + num_threads - 1) / num_threads;
+
+		std::atomic<int64_t> best_size{ 0 };
+		auto check_row = [&](std::size_t task_idx)
+			{
+				// parallel_for gives each thread a contiguous run of tasks, so deal from the rows like a deck of cards.
+				const std::size_t row_idx = (task_idx % rows_per_thread) * num_threads + task_idx / rows_per_thread;
+				if (row_idx >= rows.size()) return;
+				const Candidate& row = rows[row_idx];
+				if (row.size <= best_size.load(std::memory_order_relaxed)) return;
+
+				std::vector<Candidate> candidates;
+				const int64_t size_to_beat = best_size.load(std::memory_order_relaxed);
+				for (uint32_t second_idx = row.first_idx + 1; second_idx < tiles.size(); ++second_idx)
+				{
+					const int64_t size = get_rectangle_size_p1(tiles[row.first_idx], tiles[second_idx]);
+					if (size > size_to_beat)
+					{
+						candidates.push_back(Candidate{ size, row.first_idx, second_idx });
+					}
+				}
+				stdr::sort(candidates, stdr::greater{}, &Candidate::size);
+
+				for (const Candidate& candidate : candidates)
+				{
+					int64_t current_best = best_size.load(std::memory_order_relaxed);
+					if (candidate.size <= current_best) return;
+					if (!engine.contains_rectangle(tiles[candidate.first_idx], tiles[candidate.second_idx])) continue;
+					while (current_best < candidate.size && !best_size.compare_exchange_weak(current_best, candidate.size, std::memory_order_relaxed)) {}
+					return;
+				}
+			};
+		utils::parallel_for(rows_per_thread * num_threads, check_row, num_threads);
+		return best_size.load();
+	}
+
+	template <P2Engine engine>
+	int64_t solve_p2(std::string_view input)
+	{
+		const std::vector<Tile> tiles = parse_tiles(input);
+		advent::phase_timer timer{ "solve" };
+		if constexpr (engine == P2Engine::lines)
+		{
+			return get_biggest_rectangle_p2(tiles, get_lines(tiles));
+		}
+		else
+		{
+			return get_biggest_rectangle_p2(tiles, CompressedGrid{ tiles });
+		}
+	}
 }
 
 namespace
@@ -317,26 +678,35 @@ R"(7,1
 
 ResultType testcase_nine_a()
 {
-	std::istringstream input{ TESTCASE };
-	return solve_p1(input);
+	return solve_p1(TESTCASE);
 }
 
 ResultType testcase_nine_b()
 {
-	std::istringstream input{ TESTCASE };
-	return solve_p2(input);
+	return solve_p2<P2Engine::lines>(TESTCASE);
+}
+
+ResultType testcase_nine_b_compressed_grid()
+{
+	return solve_p2<P2Engine::compressed_grid>(TESTCASE);
 }
 
 ResultType advent_nine_p1()
 {
-	auto input = advent::open_puzzle_input(9);
-	return solve_p1(input);
+	const auto input = advent::map_puzzle_input(9);
+	return solve_p1(input.view());
 }
 
 ResultType advent_nine_p2()
 {
-	auto input = advent::open_puzzle_input(9);
-	return solve_p2(input);
+	const auto input = advent::map_puzzle_input(9);
+	return solve_p2<P2Engine::lines>(input.view());
+}
+
+ResultType advent_nine_p2_compressed_grid()
+{
+	const auto input = advent::map_puzzle_input(9);
+	return solve_p2<P2Engine::compressed_grid>(input.view());
 }
 
 #undef DAY9DBG
@@ -4,6 +4,8 @@
 
 ResultType testcase_nine_a();
 ResultType testcase_nine_b();
+ResultType testcase_nine_b_compressed_grid();
 
 ResultType advent_nine_p1();
 ResultType advent_nine_p2();
+ResultType advent_nine_p2_compressed_grid();
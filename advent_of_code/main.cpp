@@ -13,11 +13,23 @@ int main(int argc, char** argv)
 	// and advent_eighteen_p2() (as well as any other test functions with "eighteen"
 	// in the function name.
 	// Leave blank to run everything.
+	// Arguments starting with "--" are options instead of filters. E.g. "--bench=20".
 	std::vector<std::string_view> filters;
 	filters.reserve(argc - 1);
+	verify_options options;
 	for(int i=1;i<argc;++i)
 	{
-		filters.push_back(argv[i]);
+		const std::string_view arg{ argv[i] };
+		if (!arg.starts_with("--"))
+		{
+			filters.push_back(arg);
+		}
+		else if (!parse_option(options, arg))
+		{
+			std::cerr << "Unrecognised option '" << arg << "'\n";
+			print_options_help();
+			return 1;
+		}
 	}
 
 	if (filters.empty())
@@ -25,11 +37,14 @@ int main(int argc, char** argv)
 		filters = std::move(advent::default_test_filters);
 	}
 
-	verify_all(filters);
+	const bool success = verify_all(filters, options);
 
 #ifndef WIN32
-	std::cout << "Program finished. Press any key to continue.";
-	std::cin.get();
+	if (options.format == output_format::human)
+	{
+		std::cout << "Program finished. Press any key to continue.";
+		std::cin.get();
+	}
 #endif
-	return 0;
+	return success ? 0 : 1;
 }
\ No newline at end of file
@@ -9,13 +9,22 @@
 #include <iomanip>
 #include <cassert>
 #include <numeric>
+#include <cmath>
+#include <charconv>
+#include <mutex>
+#include <span>
+#include <fstream>
+#include <map>
 
 #include "advent/advent_of_code.h"
 #include "advent/advent_headers.h"
 #include "advent/advent_setup.h"
 #include "advent/advent_assert.h"
+#include "advent/advent_perf_counters.h"
+#include "advent/advent_phase_timer.h"
 
 #include "utils/tests/utils_tests.h"
+#include "utils/parallel_for.h"
 
 namespace
 {
@@ -46,6 +55,27 @@ enum class test_status : char
 	filtered
 };
 
+// Spread of times over all the timed runs of a test.
+struct timing_stats
+{
+	std::size_t repetitions = 0;
+	std::chrono::nanoseconds min{};
+	std::chrono::nanoseconds median{};
+	std::chrono::nanoseconds p90{};
+	std::chrono::nanoseconds p99{};
+	std::chrono::nanoseconds max{};
+	std::chrono::nanoseconds std_dev{};
+};
+
+// How a test's time compares to the baseline run.
+enum class timing_change : char
+{
+	no_baseline,
+	faster,
+	within_noise,
+	slower
+};
+
 // Full results of a test.
 struct test_result
 {
@@ -54,6 +84,11 @@ struct test_result
 	std::string expected;
 	test_status status = test_status::unknown;
 	std::chrono::nanoseconds time_taken{};
+	timing_stats stats;
+	timing_change change = timing_change::no_baseline;
+	std::chrono::nanoseconds baseline_time{};
+	advent::perf_counts counters;
+	advent::phase_times phases;
 };
 
 template <test_status status>
@@ -155,6 +190,15 @@ std::string to_human_readable(std::chrono::nanoseconds time)
 	return to_human_readable(us);
 }
 
+// Guards the log while tests are running on several threads.
+std::mutex output_mutex;
+
+// Human readable output. Machine readable reports own std::cout, so this moves out of their way.
+std::ostream& get_log(const verify_options& options)
+{
+	return options.format == output_format::human ? std::cout : std::cerr;
+}
+
 template <typename TestType>
 ResultType test_execute_wrapper(TestType test)
 {
@@ -172,6 +216,52 @@ ResultType test_execute_wrapper(TestType test)
 #endif
 }
 
+// Uses the nearest-rank method. Input must be sorted.
+std::chrono::nanoseconds get_percentile(const std::vector<std::chrono::nanoseconds>& sorted_times, std::size_t percentile)
+{
+	AdventCheck(!sorted_times.empty());
+	const std::size_t rank = (percentile * sorted_times.size() + 99) / 100;
+	return sorted_times[std::max(rank, std::size_t{ 1 }) - 1];
+}
+
+timing_stats get_timing_stats(std::vector<std::chrono::nanoseconds> times)
+{
+	AdventCheck(!times.empty());
+	std::ranges::sort(times);
+	const double num_times = static_cast<double>(times.size());
+	auto get_ns = [](std::chrono::nanoseconds t) { return static_cast<double>(t.count()); };
+	const double mean = std::transform_reduce(begin(times), end(times), 0.0, std::plus<double>{}, get_ns) / num_times;
+	auto get_sq_diff = [mean, &get_ns](std::chrono::nanoseconds t)
+		{
+			const double diff = get_ns(t) - mean;
+			return diff * diff;
+		};
+	const double variance = std::transform_reduce(begin(times), end(times), 0.0, std::plus<double>{}, get_sq_diff) / num_times;
+
+	timing_stats result;
+	result.repetitions = times.size();
+	result.min = times.front();
+	result.median = get_percentile(times, 50);
+	result.p90 = get_percentile(times, 90);
+	result.p99 = get_percentile(times, 99);
+	result.max = times.back();
+	result.std_dev = std::chrono::nanoseconds{ std::llround(std::sqrt(variance)) };
+	return result;
+}
+
+std::string stats_to_string(const timing_stats& stats)
+{
+	std::ostringstream oss;
+	oss << "min=" << to_human_readable(stats.min)
+		<< " median=" << to_human_readable(stats.median)
+		<< " p90=" << to_human_readable(stats.p90)
+		<< " p99=" << to_human_readable(stats.p99)
+		<< " max=" << to_human_readable(stats.max)
+		<< " sd=" << to_human_readable(stats.std_dev)
+		<< " over " << stats.repetitions << " runs";
+	return oss.str();
+}
+
 template <typename TestType>
 std::pair<ResultType,std::chrono::nanoseconds> run_test_func(TestType test)
 {
@@ -181,13 +271,126 @@ std::pair<ResultType,std::chrono::nanoseconds> run_test_func(TestType test)
 	return std::pair{res, end_time - start_time};
 }
 
+void warn_if_perf_counters_unavailable(const advent::perf_counts& counts)
+{
+	static std::once_flag warning_flag;
+	if (counts.empty())
+	{
+		std::call_once(warning_flag, []()
+			{
+				std::cerr << "\nWARNING! Performance counters are not available on this system, so none will be reported.\n";
+			});
+	}
+}
+
+struct execution_result
+{
+	ResultType result;
+	timing_stats stats;
+
+	// Averaged over the timed runs.
+	advent::perf_counts counters;
+	advent::phase_times phases;
+};
+
+// Phases line up by name, since a phase could be skipped on some runs.
+void add_phases(advent::phase_times& total, const advent::phase_times& phases)
+{
+	for (const auto& [name, time] : phases)
+	{
+		const auto find_result = std::ranges::find(total, name, &advent::phase_times::value_type::first);
+		if (find_result != end(total))
+		{
+			find_result->second += time;
+		}
+		else
+		{
+			total.emplace_back(name, time);
+		}
+	}
+}
+
+std::string phases_to_string(const advent::phase_times& phases)
+{
+	std::ostringstream oss;
+	bool is_first = true;
+	for (const auto& [name, time] : phases)
+	{
+		oss << (is_first ? "" : " ") << name << '=' << to_human_readable(time);
+		is_first = false;
+	}
+	return oss.str();
+}
+
+// Each run gets its own copy of the test, because executing a test can consume its argument.
 struct TestExecutor
 {
+	const verify_options& options;
+
 	template <typename TestType>
-	std::pair<ResultType,std::chrono::nanoseconds> operator()(TestType test) { return run_test_func(std::move(test)); }
+	execution_result operator()(const TestType& test)
+	{
+		for (std::size_t i = 0; i < options.get_warmup(); ++i)
+		{
+			run_test_func(test);
+		}
+
+		// Counters follow this thread and any threads it starts, so this still works when tests run in parallel.
+		std::optional<advent::perf_counter_group> counter_group;
+		if (options.collect_perf_counters)
+		{
+			counter_group.emplace();
+		}
+
+		std::optional<ResultType> result;
+		std::vector<std::chrono::nanoseconds> times;
+		advent::perf_counts total_counters;
+		advent::phase_times total_phases;
+		const std::size_t repetitions = std::max(options.repetitions, std::size_t{ 1 });
+		times.reserve(repetitions);
+		for (std::size_t i = 0; i < repetitions; ++i)
+		{
+			if (counter_group.has_value()) counter_group->start();
+			advent::start_phase_recording();
+			auto [res, time_taken] = run_test_func(test);
+			add_phases(total_phases, advent::stop_phase_recording());
+			if (counter_group.has_value())
+			{
+				const advent::perf_counts counts = counter_group->stop();
+				if (i == 0)
+				{
+					total_counters = counts;
+				}
+				else
+				{
+					total_counters += counts;
+				}
+			}
+			times.push_back(time_taken);
+			if (!result.has_value())
+			{
+				result = std::move(res);
+			}
+			else if (res != *result)
+			{
+				return execution_result{ ResultType{ "ERROR: Result changed between runs" }, get_timing_stats(std::move(times)) };
+			}
+		}
+
+		if (counter_group.has_value())
+		{
+			warn_if_perf_counters_unavailable(total_counters);
+			total_counters /= repetitions;
+		}
+		for (auto& [name, time] : total_phases)
+		{
+			time /= repetitions;
+		}
+		return execution_result{ std::move(*result), get_timing_stats(std::move(times)), total_counters, std::move(total_phases) };
+	}
 };
 
-test_result run_test(const verification_test& test, const std::vector<std::string_view>& filter)
+test_result run_test(const verification_test& test, const std::vector<std::string_view>& filter, const verify_options& options)
 {
 	if(!filter.empty())
 	{
@@ -206,13 +409,42 @@ test_result run_test(const verification_test& test, const std::vector<std::strin
 			};
 		}
 	}
-	std::cout << "Running test " << test.name << "...";
-	const auto [res,time_taken] = std::visit(TestExecutor{}, test.test_func);
+	// When tests run in parallel the "Running" lines would be meaningless, so only report when they finish.
+	const bool is_parallel = utils::get_num_worker_threads(options.num_threads) > 1;
+	if (!is_parallel)
+	{
+		get_log(options) << "Running test " << test.name << "...\n";
+	}
+	const auto [res,stats,counters,phases] = std::visit(TestExecutor{ options }, test.test_func);
 	const auto string_result = to_string(res);
-	std::cout << "\nFinished " << test.name << ": took " << to_human_readable(time_taken) <<  " and got " << string_result << '\n';
+
+	// In benchmark mode the median is the representative time.
+	const std::chrono::nanoseconds time_taken = stats.median;
+	std::ostringstream progress;
+	progress << "Finished " << test.name << ": took " << to_human_readable(time_taken);
+	if (!counters.empty())
+	{
+		progress << " [" << advent::to_string(counters) << ']';
+	}
+	progress << " and got " << string_result << '\n';
+	if (stats.repetitions > 1)
+	{
+		progress << "    " << stats_to_string(stats) << '\n';
+	}
+	if (!phases.empty())
+	{
+		progress << "    Phases: " << phases_to_string(phases) << '\n';
+	}
+	{
+		std::scoped_lock lock{ output_mutex };
+		get_log(options) << progress.str();
+	}
 	auto get_result = [&](test_status status)
 	{
-		return test_result{ test.name,string_result,to_string(test.expected_result),status,time_taken };
+		test_result result{ test.name,string_result,to_string(test.expected_result),status,time_taken,stats };
+		result.counters = counters;
+		result.phases = phases;
+		return result;
 	};
 
 	if(!test.expected_result.has_value())
@@ -225,33 +457,486 @@ test_result run_test(const verification_test& test, const std::vector<std::strin
 	}
 }
 
+std::string escape_json(std::string_view in)
+{
+	std::ostringstream oss;
+	for (char c : in)
+	{
+		switch (c)
+		{
+		case '"':
+			oss << "\\\"";
+			break;
+		case '\\':
+			oss << "\\\\";
+			break;
+		case '\n':
+			oss << "\\n";
+			break;
+		case '\t':
+			oss << "\\t";
+			break;
+		default:
+			if (static_cast<unsigned char>(c) < 0x20)
+			{
+				oss << "\\u" << std::hex << std::setfill('0') << std::setw(4) << static_cast<int>(c) << std::dec;
+			}
+			else
+			{
+				oss << c;
+			}
+			break;
+		}
+	}
+	return oss.str();
+}
+
+// Always quoted, so commas and newlines in results are safe.
+std::string escape_csv(std::string_view in)
+{
+	std::string result{ '"' };
+	for (char c : in)
+	{
+		if (c == '"') result.push_back('"');
+		result.push_back(c);
+	}
+	result.push_back('"');
+	return result;
+}
+
+std::string_view to_string(timing_change change)
+{
+	switch (change)
+	{
+	case timing_change::faster:
+		return "faster";
+	case timing_change::within_noise:
+		return "within_noise";
+	case timing_change::slower:
+		return "slower";
+	default:
+		break;
+	}
+	return "no_baseline";
+}
+
+std::string_view to_string(test_status status)
+{
+	switch (status)
+	{
+	case test_status::pass:
+		return "pass";
+	case test_status::fail:
+		return "fail";
+	case test_status::filtered:
+		return "filtered";
+	default:
+		break;
+	}
+	return "unknown";
+}
+
+void write_json_report(std::ostream& os, std::span<const test_result> results)
+{
+	os << "[";
+	bool is_first = true;
+	for (const test_result& result : results)
+	{
+		if (result.status == test_status::filtered) continue;
+		os << (is_first ? "\n" : ",\n");
+		is_first = false;
+		const timing_stats& stats = result.stats;
+		os << "  {"
+			<< "\"name\": \"" << escape_json(result.name) << "\", "
+			<< "\"status\": \"" << to_string(result.status) << "\", "
+			<< "\"expected\": \"" << escape_json(result.expected) << "\", "
+			<< "\"result\": \"" << escape_json(result.result) << "\", "
+			<< "\"time_ns\": " << result.time_taken.count() << ", "
+			<< "\"repetitions\": " << stats.repetitions << ", "
+			<< "\"min_ns\": " << stats.min.count() << ", "
+			<< "\"median_ns\": " << stats.median.count() << ", "
+			<< "\"p90_ns\": " << stats.p90.count() << ", "
+			<< "\"p99_ns\": " << stats.p99.count() << ", "
+			<< "\"max_ns\": " << stats.max.count() << ", "
+			<< "\"stddev_ns\": " << stats.std_dev.count() << ", "
+			<< "\"baseline_ns\": " << result.baseline_time.count() << ", "
+			<< "\"vs_baseline\": \"" << to_string(result.change) << "\"";
+		for (advent::perf_counter counter : advent::ALL_PERF_COUNTERS)
+		{
+			os << ", \"" << advent::to_string(counter) << "\": ";
+			const auto& count = result.counters[counter];
+			if (count.has_value())
+			{
+				os << *count;
+			}
+			else
+			{
+				os << "null";
+			}
+		}
+		os << ", \"phases_ns\": {";
+		for (bool is_first_phase = true; const auto& [name, time] : result.phases)
+		{
+			os << (is_first_phase ? "" : ", ") << '"' << escape_json(name) << "\": " << time.count();
+			is_first_phase = false;
+		}
+		os << "}}";
+	}
+	os << "\n]\n";
+}
+
+void write_csv_report(std::ostream& os, std::span<const test_result> results)
+{
+	os << "name,status,expected,result,time_ns,repetitions,min_ns,median_ns,p90_ns,p99_ns,max_ns,stddev_ns,baseline_ns,vs_baseline";
+	for (advent::perf_counter counter : advent::ALL_PERF_COUNTERS)
+	{
+		os << ',' << advent::to_string(counter);
+	}
+	os << ",phases_ns\n";
+	for (const test_result& result : results)
+	{
+		if (result.status == test_status::filtered) continue;
+		const timing_stats& stats = result.stats;
+		os << escape_csv(result.name) << ','
+			<< to_string(result.status) << ','
+			<< escape_csv(result.expected) << ','
+			<< escape_csv(result.result) << ','
+			<< result.time_taken.count() << ','
+			<< stats.repetitions << ','
+			<< stats.min.count() << ','
+			<< stats.median.count() << ','
+			<< stats.p90.count() << ','
+			<< stats.p99.count() << ','
+			<< stats.max.count() << ','
+			<< stats.std_dev.count() << ','
+			<< result.baseline_time.count() << ','
+			<< to_string(result.change);
+		for (advent::perf_counter counter : advent::ALL_PERF_COUNTERS)
+		{
+			os << ',';
+			const auto& count = result.counters[counter];
+			if (count.has_value())
+			{
+				os << *count;
+			}
+		}
+
+		// All the phases go in one field, as "name=time;name=time".
+		std::ostringstream phases;
+		for (bool is_first_phase = true; const auto& [name, time] : result.phases)
+		{
+			phases << (is_first_phase ? "" : ";") << name << '=' << time.count();
+			is_first_phase = false;
+		}
+		os << ',' << escape_csv(phases.str()) << '\n';
+	}
+}
+
+// Splits a line written by write_csv_report back into fields.
+std::vector<std::string> split_csv_line(std::string_view line)
+{
+	std::vector<std::string> result(1);
+	bool in_quotes = false;
+	for (std::size_t i = 0; i < line.size(); ++i)
+	{
+		const char c = line[i];
+		if (c == '"')
+		{
+			if (in_quotes && i + 1 < line.size() && line[i + 1] == '"')
+			{
+				result.back().push_back('"');
+				++i;
+			}
+			else
+			{
+				in_quotes = !in_quotes;
+			}
+		}
+		else if (c == ',' && !in_quotes)
+		{
+			result.emplace_back();
+		}
+		else if (c != '\r')
+		{
+			result.back().push_back(c);
+		}
+	}
+	return result;
+}
+
+struct baseline_timing
+{
+	std::chrono::nanoseconds time{};
+	std::chrono::nanoseconds std_dev{};
+};
+
+// Columns are found by name, so baselines from older runs with fewer columns still load.
+std::optional<std::map<std::string, baseline_timing>> load_baseline(const std::string& filename)
+{
+	std::ifstream input{ filename };
+	if (!input.is_open())
+	{
+		std::cerr << "ERROR! Could not open baseline file '" << filename << "'\n";
+		return std::nullopt;
+	}
+
+	std::string line;
+	std::getline(input, line);
+	const std::vector<std::string> header = split_csv_line(line);
+	auto get_column = [&header](std::string_view column_name) -> std::optional<std::size_t>
+		{
+			const auto find_result = std::ranges::find(header, column_name);
+			if (find_result == end(header)) return std::nullopt;
+			return std::distance(begin(header), find_result);
+		};
+	const auto name_col = get_column("name");
+	const auto time_col = get_column("time_ns");
+	const auto std_dev_col = get_column("stddev_ns");
+	if (!name_col.has_value() || !time_col.has_value())
+	{
+		std::cerr << "ERROR! Baseline file '" << filename << "' needs 'name' and 'time_ns' columns\n";
+		return std::nullopt;
+	}
+
+	auto to_ns = [](const std::string& field)
+		{
+			long long result = 0;
+			std::from_chars(field.data(), field.data() + field.size(), result);
+			return std::chrono::nanoseconds{ result };
+		};
+
+	std::map<std::string, baseline_timing> result;
+	while (std::getline(input, line))
+	{
+		if (line.empty()) continue;
+		const std::vector<std::string> fields = split_csv_line(line);
+		if (fields.size() != header.size())
+		{
+			std::cerr << "WARNING! Skipping malformed line in baseline file: " << line << '\n';
+			continue;
+		}
+		baseline_timing& timing = result[fields[*name_col]];
+		timing.time = to_ns(fields[*time_col]);
+		if (std_dev_col.has_value())
+		{
+			timing.std_dev = to_ns(fields[*std_dev_col]);
+		}
+	}
+	return result;
+}
+
+// A change only counts if it is bigger than the threshold and bigger than the noise seen in either run.
+// Below a microsecond the clock resolution dominates, so those differences never count.
+timing_change compare_to_baseline(const test_result& result, const baseline_timing& baseline, std::size_t threshold_percent)
+{
+	using namespace std::chrono_literals;
+	const std::chrono::nanoseconds relative_band{ baseline.time.count() * static_cast<std::chrono::nanoseconds::rep>(threshold_percent) / 100 };
+	const std::chrono::nanoseconds noise_band = 2 * std::max(baseline.std_dev, result.stats.std_dev);
+	const std::chrono::nanoseconds band = std::max({ relative_band, noise_band, std::chrono::nanoseconds{ 1us } });
+	const auto difference = result.time_taken - baseline.time;
+	if (difference > band) return timing_change::slower;
+	if (-difference > band) return timing_change::faster;
+	return timing_change::within_noise;
+}
+
+// Returns false if the baseline could not be loaded.
+bool apply_baseline(const verify_options& options, std::span<test_result> results)
+{
+	const auto baseline = load_baseline(options.baseline_file);
+	if (!baseline.has_value()) return false;
+	for (test_result& result : results)
+	{
+		if (result.status == test_status::filtered) continue;
+		const auto find_result = baseline->find(result.name);
+		if (find_result == end(*baseline)) continue;
+		result.baseline_time = find_result->second.time;
+		result.change = compare_to_baseline(result, find_result->second, options.threshold_percent);
+	}
+	return true;
+}
+
+std::string baseline_comparison_to_string(const test_result& result)
+{
+	std::ostringstream oss;
+	const auto difference = result.time_taken - result.baseline_time;
+	oss << to_string(result.change) << ": " << to_human_readable(result.time_taken) << " vs " << to_human_readable(result.baseline_time);
+	if (result.baseline_time.count() > 0)
+	{
+		oss << " (" << std::showpos << 100 * difference.count() / result.baseline_time.count() << std::noshowpos << "%)";
+	}
+	return oss.str();
+}
+
+void write_report(const verify_options& options, std::span<const test_result> results)
+{
+	std::ofstream output_file;
+	if (!options.output_file.empty())
+	{
+		output_file.open(options.output_file);
+		if (!output_file.is_open())
+		{
+			std::cerr << "ERROR! Could not open '" << options.output_file << "' for writing. Writing the report to stdout instead.\n";
+		}
+	}
+	std::ostream& os = output_file.is_open() ? static_cast<std::ostream&>(output_file) : std::cout;
+
+	switch (options.format)
+	{
+	case output_format::json:
+		write_json_report(os, results);
+		break;
+	case output_format::csv:
+		write_csv_report(os, results);
+		break;
+	default:
+		break;
+	}
+}
+
+bool parse_option(verify_options& options, std::string_view arg)
+{
+	auto get_value = [&arg](std::string_view option, std::optional<std::size_t> default_value) -> std::optional<std::size_t>
+		{
+			if (arg == option)
+			{
+				return default_value;
+			}
+			if (!arg.starts_with(option) || arg[option.size()] != '=')
+			{
+				return std::nullopt;
+			}
+			const std::string_view value = arg.substr(option.size() + 1);
+			std::size_t result = 0;
+			const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+			if (ec != std::errc{} || ptr != value.data() + value.size())
+			{
+				return std::nullopt;
+			}
+			return result;
+		};
+
+	if (const auto reps = get_value("--bench", 10))
+	{
+		options.repetitions = std::max(*reps, std::size_t{ 1 });
+		return true;
+	}
+	if (const auto warmup = get_value("--warmup", std::nullopt))
+	{
+		options.warmup = *warmup;
+		return true;
+	}
+	if (const auto jobs = get_value("--jobs", 0))
+	{
+		options.num_threads = *jobs;
+		return true;
+	}
+	if (arg == "--perf")
+	{
+		options.collect_perf_counters = true;
+		return true;
+	}
+	if (const auto threshold = get_value("--threshold", std::nullopt))
+	{
+		options.threshold_percent = *threshold;
+		return true;
+	}
+	if (arg.starts_with("--baseline=") && arg.size() > std::string_view{ "--baseline=" }.size())
+	{
+		options.baseline_file = arg.substr(std::string_view{ "--baseline=" }.size());
+		return true;
+	}
+	if (arg == "--format=human")
+	{
+		options.format = output_format::human;
+		return true;
+	}
+	if (arg == "--format=json")
+	{
+		options.format = output_format::json;
+		return true;
+	}
+	if (arg == "--format=csv")
+	{
+		options.format = output_format::csv;
+		return true;
+	}
+	if (arg.starts_with("--output=") && arg.size() > std::string_view{ "--output=" }.size())
+	{
+		options.output_file = arg.substr(std::string_view{ "--output=" }.size());
+		return true;
+	}
+	return false;
+}
+
+void print_options_help()
+{
+	std::cerr <<
+		"Options:\n"
+		"    --bench[=N]   Benchmark mode: time N runs of each test (default 10) and report the spread.\n"
+		"    --warmup=N    Untimed runs of each test before timing starts (default 1 in benchmark mode, otherwise 0).\n"
+		"    --jobs[=N]    Run tests on N threads (every core if N is left off or 0). Results are still listed in order.\n"
+		"    --format=F    Report format: human (default), json or csv. Other output moves to stderr for json and csv.\n"
+		"    --output=FILE Write the json or csv report to FILE instead of stdout.\n"
+		"    --baseline=FILE Compare times against a csv report from an earlier run, and fail on any regression.\n"
+		"    --threshold=N How much slower than the baseline, in percent, counts as a regression (default 10).\n"
+		"    --perf        Count instructions, cycles, cache misses, branch mispredicts and page faults for each test (Linux only).\n"
+		"Any other argument is a filter on the test names.\n";
+}
+
 bool verify_all(const std::vector<std::string_view>& filter)
+{
+	return verify_all(filter, verify_options{});
+}
+
+bool verify_all(const std::vector<std::string_view>& filter, const verify_options& options)
 {
 #if UTILS_TESTING
 	const std::size_t NUM_TESTS = std::size(tests) + utils::testing::get_all_tests().size();
 	std::vector<test_result> results;
-	results.reserve(NUM_TESTS);
-	results.resize(std::size(tests));
+	results.resize(NUM_TESTS);
 #else
 	constexpr auto NUM_TESTS = std::size(tests);
 	auto result_ptr = std::make_unique<std::array<test_result, NUM_TESTS>>();
 	auto& results = *result_ptr;
 #endif
 
-	auto test_lambda = [&filter](const verification_test& test)
+	// Results are stored by position, so they are reported in table order however the tests get scheduled.
+	auto run_tests = [&filter, &options](std::span<const verification_test> test_list, auto results_it)
 		{
-			return run_test(test, filter);
+			auto run_one = [&](std::size_t idx)
+				{
+					results_it[idx] = run_test(test_list[idx], filter, options);
+				};
+			utils::parallel_for(test_list.size(), run_one, options.num_threads);
 		};
-	std::ranges::transform(tests, begin(results),test_lambda);
+	run_tests(tests, begin(results));
 
 #if UTILS_TESTING
-	std::ranges::transform(utils::testing::get_all_tests(), std::back_inserter(results), test_lambda);
+	run_tests(utils::testing::get_all_tests(), begin(results) + std::size(tests));
 #endif
 
+	const bool baseline_loaded = options.baseline_file.empty() || apply_baseline(options, results);
+
 	auto result_to_string = [&filter](const test_result& result)
 	{
 		std::ostringstream oss;
 		oss << result.name << ": " << result.result << " - ";
+		if (result.stats.repetitions > 1 && result.status != test_status::filtered)
+		{
+			oss << '[' << stats_to_string(result.stats) << "] ";
+		}
+		if (result.change != timing_change::no_baseline)
+		{
+			oss << '[' << baseline_comparison_to_string(result) << "] ";
+		}
+		if (!result.counters.empty())
+		{
+			oss << '[' << advent::to_string(result.counters) << "] ";
+		}
+		if (!result.phases.empty())
+		{
+			oss << '[' << phases_to_string(result.phases) << "] ";
+		}
 		switch (result.status)
 		{
 		case test_status::pass:
@@ -269,7 +954,8 @@ bool verify_all(const std::vector<std::string_view>& filter)
 		return oss.str();
 	};
 
-	std::ranges::transform(results,std::ostream_iterator<std::string>(std::cout), result_to_string);
+	std::ostream& log = get_log(options);
+	std::ranges::transform(results,std::ostream_iterator<std::string>(log), result_to_string);
 
 	auto get_count = [&results](auto pred)
 	{
@@ -279,13 +965,32 @@ bool verify_all(const std::vector<std::string_view>& filter)
 	const auto total_time = std::transform_reduce(begin(results), end(results), std::chrono::nanoseconds{ 0 },
 		std::plus<std::chrono::nanoseconds>{}, [](const test_result& result) {return result.time_taken; });
 
-	std::cout << 
+	log << 
 		"RESULTS:\n"
 		"    PASSED : " << get_count(check_result<test_status::pass>) << "\n"
 		"    FAILED : " << get_count(check_result<test_status::fail>) << "\n"
 		"    UNKNOWN: " << get_count(check_result<test_status::unknown>) << "\n"
 		"    TIME   : " << to_human_readable(total_time) << '\n';
-	return std::ranges::none_of(results,check_result<test_status::fail>);
+
+	const auto num_slower = std::ranges::count(results, timing_change::slower, &test_result::change);
+	if (!options.baseline_file.empty())
+	{
+		log <<
+			"BASELINE:\n"
+			"    FASTER : " << std::ranges::count(results, timing_change::faster, &test_result::change) << "\n"
+			"    SAME   : " << std::ranges::count(results, timing_change::within_noise, &test_result::change) << "\n"
+			"    SLOWER : " << num_slower << "\n"
+			"    MISSING: " << std::ranges::count_if(results, [](const test_result& result)
+				{
+					return result.status != test_status::filtered && result.change == timing_change::no_baseline;
+				}) << '\n';
+	}
+
+	if (options.format != output_format::human)
+	{
+		write_report(options, results);
+	}
+	return baseline_loaded && num_slower == 0 && std::ranges::none_of(results,check_result<test_status::fail>);
 }
 
 verification_test advent_testcase_internal::make_test(std::string name, TestFunc func, std::string result)
@@ -0,0 +1,232 @@
+#include "advent/advent_perf_counters.h"
+
+#include <sstream>
+#include <iomanip>
+#include <algorithm>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+	constexpr int INVALID_FD = -1;
+
+	std::size_t to_idx(advent::perf_counter counter)
+	{
+		return static_cast<std::size_t>(counter);
+	}
+
+#ifdef __linux__
+	perf_event_attr get_attributes(advent::perf_counter counter, bool is_leader)
+	{
+		perf_event_attr result{};
+		result.size = sizeof(result);
+		// Only the leader is switched on and off. The rest of the group follows it.
+		result.disabled = is_leader ? 1 : 0;
+		result.exclude_kernel = 1;
+		result.exclude_hv = 1;
+		// Also count any threads the test starts (e.g. with parallel_for) while the counters are open.
+		result.inherit = 1;
+
+		// The whole group is read at once. Multiplexed counters only run part of the time,
+		// so ask for the times to scale them back up.
+		result.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+		switch (counter)
+		{
+		case advent::perf_counter::instructions:
+			result.type = PERF_TYPE_HARDWARE;
+			result.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+		case advent::perf_counter::cycles:
+			result.type = PERF_TYPE_HARDWARE;
+			result.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+		case advent::perf_counter::cache_misses:
+			result.type = PERF_TYPE_HARDWARE;
+			result.config = PERF_COUNT_HW_CACHE_MISSES;
+			break;
+		case advent::perf_counter::branch_misses:
+			result.type = PERF_TYPE_HARDWARE;
+			result.config = PERF_COUNT_HW_BRANCH_MISSES;
+			break;
+		case advent::perf_counter::page_faults:
+			result.type = PERF_TYPE_SOFTWARE;
+			result.config = PERF_COUNT_SW_PAGE_FAULTS;
+			break;
+		}
+		return result;
+	}
+
+	int open_counter(advent::perf_counter counter, int leader_fd)
+	{
+		perf_event_attr attributes = get_attributes(counter, leader_fd == INVALID_FD);
+		const long fd = syscall(SYS_perf_event_open, &attributes, 0, -1, leader_fd, 0);
+		return fd < 0 ? INVALID_FD : static_cast<int>(fd);
+	}
+
+	// Time enabled, time running, then the value of each counter in the group in the order they were opened.
+	// These are running totals (resetting the leader doesn't clear what finished child threads added),
+	// so a measurement is the difference between two readings.
+	std::optional<advent::perf_counter_group::reading> read_group(int leader_fd, std::size_t num_counters)
+	{
+		std::array<uint64_t, advent::NUM_PERF_COUNTERS + 3> data{};
+		const auto expected_size = static_cast<ssize_t>((num_counters + 3) * sizeof(uint64_t));
+		if (read(leader_fd, data.data(), sizeof(data)) != expected_size) return std::nullopt;
+		if (data[0] != num_counters) return std::nullopt;
+		advent::perf_counter_group::reading result{};
+		std::copy(data.begin() + 1, data.end(), result.begin());
+		return result;
+	}
+#endif
+}
+
+const char* advent::to_string(perf_counter counter)
+{
+	switch (counter)
+	{
+	case perf_counter::instructions:
+		return "instructions";
+	case perf_counter::cycles:
+		return "cycles";
+	case perf_counter::cache_misses:
+		return "cache_misses";
+	case perf_counter::branch_misses:
+		return "branch_misses";
+	case perf_counter::page_faults:
+		return "page_faults";
+	}
+	return "unknown";
+}
+
+bool advent::perf_counts::empty() const
+{
+	return std::ranges::none_of(counts, [](const std::optional<uint64_t>& count) { return count.has_value(); });
+}
+
+advent::perf_counts& advent::perf_counts::operator+=(const perf_counts& other)
+{
+	for (std::size_t i = 0; i < NUM_PERF_COUNTERS; ++i)
+	{
+		if (counts[i].has_value() && other.counts[i].has_value())
+		{
+			*counts[i] += *other.counts[i];
+		}
+		else
+		{
+			counts[i].reset();
+		}
+	}
+	return *this;
+}
+
+advent::perf_counts& advent::perf_counts::operator/=(uint64_t divisor)
+{
+	for (std::optional<uint64_t>& count : counts)
+	{
+		if (count.has_value())
+		{
+			*count /= divisor;
+		}
+	}
+	return *this;
+}
+
+std::string advent::to_string(const perf_counts& counts)
+{
+	std::ostringstream oss;
+	bool is_first = true;
+	for (perf_counter counter : ALL_PERF_COUNTERS)
+	{
+		if (!counts[counter].has_value()) continue;
+		oss << (is_first ? "" : " ") << to_string(counter) << '=' << *counts[counter];
+		is_first = false;
+	}
+
+	// Instructions per cycle is the quickest hint as to whether something is compute or memory bound.
+	const auto& instructions = counts[perf_counter::instructions];
+	const auto& cycles = counts[perf_counter::cycles];
+	if (instructions.has_value() && cycles.has_value() && *cycles > 0)
+	{
+		oss << " ipc=" << std::fixed << std::setprecision(2) << static_cast<double>(*instructions) / static_cast<double>(*cycles);
+	}
+	return oss.str();
+}
+
+advent::perf_counter_group::perf_counter_group()
+{
+	m_fds.fill(INVALID_FD);
+#ifdef __linux__
+	// The first counter that opens leads the group. Any that can't join it are left out.
+	for (perf_counter counter : ALL_PERF_COUNTERS)
+	{
+		m_fds[to_idx(counter)] = open_counter(counter, get_leader_fd());
+	}
+#endif
+}
+
+advent::perf_counter_group::~perf_counter_group()
+{
+#ifdef __linux__
+	for (int fd : m_fds)
+	{
+		if (fd != INVALID_FD)
+		{
+			close(fd);
+		}
+	}
+#endif
+}
+
+int advent::perf_counter_group::get_leader_fd() const
+{
+	const auto leader = std::ranges::find_if(m_fds, [](int fd) { return fd != INVALID_FD; });
+	return leader != end(m_fds) ? *leader : INVALID_FD;
+}
+
+std::size_t advent::perf_counter_group::get_num_open() const
+{
+	return static_cast<std::size_t>(std::ranges::count_if(m_fds, [](int fd) { return fd != INVALID_FD; }));
+}
+
+void advent::perf_counter_group::start()
+{
+	m_start_reading.reset();
+#ifdef __linux__
+	const int leader_fd = get_leader_fd();
+	if (leader_fd == INVALID_FD) return;
+	m_start_reading = read_group(leader_fd, get_num_open());
+	ioctl(leader_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+#endif
+}
+
+advent::perf_counts advent::perf_counter_group::stop()
+{
+	perf_counts result;
+#ifdef __linux__
+	const int leader_fd = get_leader_fd();
+	if (leader_fd == INVALID_FD) return result;
+	ioctl(leader_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+	const std::optional<reading> end_reading = read_group(leader_fd, get_num_open());
+	if (!m_start_reading.has_value() || !end_reading.has_value()) return result;
+
+	const uint64_t time_enabled = (*end_reading)[0] - (*m_start_reading)[0];
+	const uint64_t time_running = (*end_reading)[1] - (*m_start_reading)[1];
+	if (time_running == 0) return result;
+	const double scale = static_cast<double>(time_enabled) / static_cast<double>(time_running);
+
+	std::size_t value_idx = 2;
+	for (perf_counter counter : ALL_PERF_COUNTERS)
+	{
+		if (m_fds[to_idx(counter)] == INVALID_FD) continue;
+		const uint64_t value = (*end_reading)[value_idx] - (*m_start_reading)[value_idx];
+		result[counter] = time_running == time_enabled ? value : static_cast<uint64_t>(static_cast<double>(value) * scale);
+		++value_idx;
+	}
+#endif
+	return result;
+}
@@ -0,0 +1,49 @@
+#include "advent/advent_phase_timer.h"
+
+#include <algorithm>
+#include <optional>
+
+namespace
+{
+	// Per thread so tests running in parallel don't mix. This also means threads a test starts itself
+	// never have a recording, so their timers are ignored.
+	thread_local std::optional<advent::phase_times> recorded_phases;
+
+	void add_phase_time(std::string_view name, std::chrono::nanoseconds time)
+	{
+		if (!recorded_phases.has_value()) return;
+		auto find_result = std::ranges::find(*recorded_phases, name, &advent::phase_times::value_type::first);
+		if (find_result != end(*recorded_phases))
+		{
+			find_result->second += time;
+		}
+		else
+		{
+			recorded_phases->emplace_back(name, time);
+		}
+	}
+}
+
+advent::phase_timer::phase_timer(std::string_view name)
+	: m_name{ name }
+	, m_start{ std::chrono::high_resolution_clock::now() }
+{
+}
+
+advent::phase_timer::~phase_timer()
+{
+	const auto end = std::chrono::high_resolution_clock::now();
+	add_phase_time(m_name, end - m_start);
+}
+
+void advent::start_phase_recording()
+{
+	recorded_phases.emplace();
+}
+
+advent::phase_times advent::stop_phase_recording()
+{
+	phase_times result = std::move(recorded_phases).value_or(phase_times{});
+	recorded_phases.reset();
+	return result;
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <vector>
+#include <numeric>
+#include <concepts>
+#include <utility>
+
+#include "advent/advent_assert.h"
+
+namespace utils
+{
+	// Union-find over the elements 0 to size-1. Uses path compression and union by size,
+	// so finds and unions are effectively constant time. Also keeps the size of every component
+	// and how many components there are.
+	template <std::unsigned_integral IndexType = std::size_t>
+	class disjoint_set
+	{
+		std::vector<IndexType> m_parents;
+		std::vector<IndexType> m_sizes;
+		IndexType m_num_components = 0;
+	public:
+		using size_type = IndexType;
+
+		disjoint_set() = default;
+		explicit disjoint_set(IndexType size)
+			: m_parents(size)
+			, m_sizes(size, IndexType{ 1 })
+			, m_num_components{ size }
+		{
+			std::iota(begin(m_parents), end(m_parents), IndexType{ 0 });
+		}
+
+		// Returns the representative of the component containing element.
+		IndexType find(IndexType element)
+		{
+			AdventCheck(element < size());
+			IndexType root = element;
+			while (m_parents[root] != root)
+			{
+				root = m_parents[root];
+			}
+			while (m_parents[element] != root)
+			{
+				element = std::exchange(m_parents[element], root);
+			}
+			return root;
+		}
+
+		// Joins the components containing a and b. Returns false if they were already the same component.
+		bool unite(IndexType a, IndexType b)
+		{
+			IndexType root_a = find(a);
+			IndexType root_b = find(b);
+			if (root_a == root_b) return false;
+			if (m_sizes[root_a] < m_sizes[root_b])
+			{
+				std::swap(root_a, root_b);
+			}
+			m_parents[root_b] = root_a;
+			m_sizes[root_a] += m_sizes[root_b];
+			--m_num_components;
+			return true;
+		}
+
+		bool same_component(IndexType a, IndexType b) { return find(a) == find(b); }
+		IndexType component_size(IndexType element) { return m_sizes[find(element)]; }
+		IndexType num_components() const noexcept { return m_num_components; }
+		IndexType size() const noexcept { return static_cast<IndexType>(m_parents.size()); }
+
+		// The size of every component, in no particular order.
+		std::vector<IndexType> component_sizes() const
+		{
+			std::vector<IndexType> result;
+			result.reserve(m_num_components);
+			for (IndexType i = 0; i < size(); ++i)
+			{
+				if (m_parents[i] == i)
+				{
+					result.push_back(m_sizes[i]);
+				}
+			}
+			AdventCheck(result.size() == m_num_components);
+			return result;
+		}
+	};
+}
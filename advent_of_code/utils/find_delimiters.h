@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <bit>
+#include <cstdint>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define UTILS_FIND_DELIMITERS_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define UTILS_FIND_DELIMITERS_SSE2 1
+#endif
+
+namespace utils
+{
+	namespace find_delimiters_internal
+	{
+		// Compares a whole block against the delimiter at once. Bit i of the result is set if block[i] == delim.
+#if UTILS_FIND_DELIMITERS_AVX2
+		constexpr std::size_t BLOCK_SIZE = 32;
+		inline uint32_t match_block(const char* block, char delim) noexcept
+		{
+			const __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+			const __m256i matches = _mm256_cmpeq_epi8(chunk, _mm256_set1_epi8(delim));
+			return static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+		}
+#elif UTILS_FIND_DELIMITERS_SSE2
+		constexpr std::size_t BLOCK_SIZE = 16;
+		inline uint32_t match_block(const char* block, char delim) noexcept
+		{
+			const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+			const __m128i matches = _mm_cmpeq_epi8(chunk, _mm_set1_epi8(delim));
+			return static_cast<uint32_t>(_mm_movemask_epi8(matches));
+		}
+#else
+		constexpr std::size_t BLOCK_SIZE = 16;
+		inline uint32_t match_block(const char* block, char delim) noexcept
+		{
+			uint32_t result = 0;
+			for (std::size_t i = 0; i < BLOCK_SIZE; ++i)
+			{
+				result |= static_cast<uint32_t>(block[i] == delim) << i;
+			}
+			return result;
+		}
+#endif
+	}
+
+	// Returns the index of the first delim at or after from, or std::string_view::npos.
+	// Checks a whole SIMD register's worth of characters per step where the target supports it.
+	[[nodiscard]] inline std::size_t find_delimiter(std::string_view str, char delim, std::size_t from = 0) noexcept
+	{
+		using namespace find_delimiters_internal;
+		const char* data = str.data();
+		std::size_t pos = from;
+		for (; pos + BLOCK_SIZE <= str.size(); pos += BLOCK_SIZE)
+		{
+			if (const uint32_t mask = match_block(data + pos, delim); mask != 0)
+			{
+				return pos + std::countr_zero(mask);
+			}
+		}
+		for (; pos < str.size(); ++pos)
+		{
+			if (data[pos] == delim) return pos;
+		}
+		return std::string_view::npos;
+	}
+
+	// Appends the index of every delim in str to out, in order, in a single pass.
+	inline void find_delimiters(std::string_view str, char delim, std::vector<std::size_t>& out)
+	{
+		using namespace find_delimiters_internal;
+		const char* data = str.data();
+		std::size_t pos = 0;
+		for (; pos + BLOCK_SIZE <= str.size(); pos += BLOCK_SIZE)
+		{
+			for (uint32_t mask = match_block(data + pos, delim); mask != 0; mask &= mask - 1)
+			{
+				out.push_back(pos + std::countr_zero(mask));
+			}
+		}
+		for (; pos < str.size(); ++pos)
+		{
+			if (data[pos] == delim) out.push_back(pos);
+		}
+	}
+
+	[[nodiscard]] inline std::vector<std::size_t> find_delimiters(std::string_view str, char delim)
+	{
+		std::vector<std::size_t> result;
+		find_delimiters(str, delim, result);
+		return result;
+	}
+}
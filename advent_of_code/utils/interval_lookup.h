@@ -0,0 +1,95 @@
+#pragma once
+
+#include "interval_set.h"
+
+#include <vector>
+#include <span>
+#include <bit>
+#include <limits>
+#include <concepts>
+
+namespace utils
+{
+	// A read-only copy of an interval_set laid out for answering huge batches of membership queries.
+	// The intervals are kept in Eytzinger order (a binary tree stored breadth first, so the top levels share
+	// a few cache lines), padded out to a complete tree. Every search then takes exactly the same number of steps
+	// with no branches, so count_contained runs eight of them side by side and their memory loads overlap.
+	template <std::integral T>
+	class interval_lookup
+	{
+		// Entry k's children are 2k and 2k+1. Entry 0 is a sentinel that contains nothing, and padding entries
+		// sort after every real interval.
+		std::vector<T> m_ends;
+		std::vector<T> m_starts;
+		int m_depth = 0;
+
+		void build(const interval_set<T>& intervals, typename interval_set<T>::const_iterator& next, std::size_t k)
+		{
+			if (k >= m_ends.size()) return;
+			build(intervals, next, 2 * k);
+			if (next != intervals.end())
+			{
+				m_starts[k] = next->first;
+				m_ends[k] = next->second;
+				++next;
+			}
+			build(intervals, next, 2 * k + 1);
+		}
+
+		// Goes down to the first interval that ends after value (0 if there isn't one), which is the only one that can hold it.
+		bool is_in_found(std::size_t k, T value) const
+		{
+			k >>= std::countr_one(k) + 1;
+			return m_starts[k] <= value && value < m_ends[k];
+		}
+	public:
+		explicit interval_lookup(const interval_set<T>& intervals)
+		{
+			m_depth = std::bit_width(intervals.size());
+			const std::size_t tree_size = std::size_t{ 1 } << m_depth;
+			m_starts.assign(tree_size, std::numeric_limits<T>::max());
+			m_ends.assign(tree_size, std::numeric_limits<T>::max());
+			m_ends[0] = std::numeric_limits<T>::min();
+			auto next = intervals.begin();
+			build(intervals, next, 1);
+		}
+
+		bool contains(T value) const
+		{
+			std::size_t k = 1;
+			for (int level = 0; level < m_depth; ++level)
+			{
+				k = 2 * k + (m_ends[k] <= value);
+			}
+			return is_in_found(k, value);
+		}
+
+		std::size_t count_contained(std::span<const T> values) const
+		{
+			constexpr std::size_t LANES = 8;
+			std::size_t result = 0;
+			std::size_t i = 0;
+			for (; i + LANES <= values.size(); i += LANES)
+			{
+				std::size_t found[LANES];
+				std::fill(std::begin(found), std::end(found), std::size_t{ 1 });
+				for (int level = 0; level < m_depth; ++level)
+				{
+					for (std::size_t lane = 0; lane < LANES; ++lane)
+					{
+						found[lane] = 2 * found[lane] + (m_ends[found[lane]] <= values[i + lane]);
+					}
+				}
+				for (std::size_t lane = 0; lane < LANES; ++lane)
+				{
+					result += is_in_found(found[lane], values[i + lane]) ? 1 : 0;
+				}
+			}
+			for (; i < values.size(); ++i)
+			{
+				result += contains(values[i]) ? 1 : 0;
+			}
+			return result;
+		}
+	};
+}
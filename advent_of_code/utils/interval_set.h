@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <concepts>
+#include <numeric>
+
+#include "advent/advent_assert.h"
+
+namespace utils
+{
+	// A set of values stored as half-open intervals [first,second).
+	// Like sorted_vector, inserting is cheap and the sorting is deferred: the first query sorts the intervals
+	// and merges any that overlap or touch, so after that the intervals are disjoint and lookups are binary searches.
+	template <std::integral T>
+	class interval_set
+	{
+	public:
+		using interval = std::pair<T, T>;
+		using const_iterator = typename std::vector<interval>::const_iterator;
+	private:
+		mutable std::vector<interval> m_intervals;
+		mutable bool m_normalised = true;
+
+		void normalise() const
+		{
+			if (m_normalised) return;
+			std::ranges::sort(m_intervals);
+			auto merged_end = m_intervals.begin();
+			for (auto it = m_intervals.begin(); it != m_intervals.end(); ++it)
+			{
+				if (merged_end != m_intervals.begin() && it->first <= (merged_end - 1)->second)
+				{
+					(merged_end - 1)->second = std::max((merged_end - 1)->second, it->second);
+				}
+				else
+				{
+					*merged_end++ = *it;
+				}
+			}
+			m_intervals.erase(merged_end, m_intervals.end());
+			m_normalised = true;
+		}
+	public:
+		interval_set() = default;
+
+		void insert(T first, T last)
+		{
+			AdventCheck(first <= last);
+			if (first == last) return;
+			m_intervals.emplace_back(first, last);
+			m_normalised = m_intervals.size() < 2u;
+		}
+		void insert(const interval& i) { insert(i.first, i.second); }
+
+		void reserve(std::size_t num_intervals) { m_intervals.reserve(num_intervals); }
+
+		bool contains(T value) const
+		{
+			normalise();
+			// The last interval starting at or before value is the only one that can hold it.
+			const auto it = std::ranges::upper_bound(m_intervals, value, {}, &interval::first);
+			return it != m_intervals.begin() && value < (it - 1)->second;
+		}
+
+		// Sorts the values and then walks through them and the intervals together, which beats
+		// a binary search per value once there are a lot of them.
+		std::size_t count_contained(std::vector<T> values) const
+		{
+			normalise();
+			std::ranges::sort(values);
+			std::size_t result = 0;
+			auto interval_it = m_intervals.begin();
+			for (T value : values)
+			{
+				while (interval_it != m_intervals.end() && interval_it->second <= value)
+				{
+					++interval_it;
+				}
+				if (interval_it == m_intervals.end()) break;
+				if (interval_it->first <= value)
+				{
+					++result;
+				}
+			}
+			return result;
+		}
+
+		// The number of distinct values in the set.
+		T total_size() const
+		{
+			normalise();
+			return std::accumulate(m_intervals.begin(), m_intervals.end(), T{ 0 }, [](T total, const interval& i) { return total + (i.second - i.first); });
+		}
+
+		// The merged, disjoint intervals in order.
+		const_iterator begin() const { normalise(); return m_intervals.cbegin(); }
+		const_iterator end() const { normalise(); return m_intervals.cend(); }
+		std::size_t size() const { normalise(); return m_intervals.size(); }
+		bool empty() const { return m_intervals.empty(); }
+	};
+}
@@ -25,7 +25,8 @@ namespace utils
 				throw std::range_error{ "Cannot deference an at-the-end stream block iterator" };
 			}
 
-			std::ostringstream result_stream;
+			// This has to read a line at a time so the stream is left just after the block.
+			std::string result;
 			std::string line;
 			while (true)
 			{
@@ -34,7 +35,8 @@ namespace utils
 				{
 					break;
 				}
-				result_stream << line << '\n';
+				result.append(line);
+				result.push_back('\n');
 				if (m_stream->eof())
 				{
 					m_stream = nullptr;
@@ -42,8 +44,7 @@ namespace utils
 				}
 			}
 
-			// Get the result and remove the trailing '\n'.
-			std::string result = result_stream.str();
+			// Remove the trailing '\n'.
 			if (!result.empty())
 			{
 				AdventCheck(result.back() == '\n');
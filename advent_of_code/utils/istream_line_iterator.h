@@ -5,6 +5,13 @@
 #include <iterator>
 #include <stdexcept>
 #include <optional>
+#include <memory>
+#include <vector>
+#include <algorithm>
+
+#include "find_delimiters.h"
+
+#include "advent/advent_assert.h"
 
 namespace utils
 {
@@ -129,6 +136,155 @@ namespace utils
 
 	using istream_line_range = basic_istream_line_range<istream_iterator::blank_line_behaviour::skip>;
 	using inclusive_istream_line_range = basic_istream_line_range<istream_iterator::blank_line_behaviour::include>;
+
+	namespace istream_iterator
+	{
+		// Reads the stream in large chunks and finds lines inside the chunk, so no line is ever copied on its own.
+		// Shared by a buffered_istream_line_range and all of its iterators.
+		class line_buffer
+		{
+		public:
+			static constexpr std::size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+		private:
+			std::istream* m_stream;
+			std::vector<char> m_buffer;
+			std::size_t m_line_begin = 0;
+			std::size_t m_line_end = 0;
+			std::size_t m_next_line_begin = 0;
+			std::size_t m_data_end = 0;
+			char m_sentinental;
+			bool m_stream_exhausted = false;
+			bool m_finished = false;
+
+			// Moves the unfinished line to the front of the buffer (growing it if the line fills the whole thing)
+			// and tops the buffer up from the stream.
+			void refill()
+			{
+				const std::size_t num_kept = m_data_end - m_next_line_begin;
+				std::copy(begin(m_buffer) + m_next_line_begin, begin(m_buffer) + m_data_end, begin(m_buffer));
+				m_next_line_begin = 0;
+				m_data_end = num_kept;
+				if (m_data_end == m_buffer.size())
+				{
+					m_buffer.resize(2 * m_buffer.size());
+				}
+				m_stream->read(m_buffer.data() + m_data_end, m_buffer.size() - m_data_end);
+				const std::streamsize num_read = m_stream->gcount();
+				m_data_end += static_cast<std::size_t>(num_read);
+				if (num_read == 0 || !m_stream->good())
+				{
+					m_stream_exhausted = true;
+				}
+			}
+		public:
+			// The chunk size is how much gets read at a time. The buffer grows past it if a line doesn't fit.
+			line_buffer(std::istream& stream, char sentinental, std::size_t chunk_size = DEFAULT_CHUNK_SIZE)
+				: m_stream{ &stream }, m_buffer(chunk_size), m_sentinental{ sentinental }
+			{
+				AdventCheck(chunk_size > 0u);
+			}
+
+			// Returns false once there are no more lines. Like std::getline, the text after the last sentinental is a line
+			// even if it's empty.
+			bool advance()
+			{
+				if (m_finished) return false;
+				std::size_t search_from = m_next_line_begin;
+				while (true)
+				{
+					const std::string_view data{ m_buffer.data(), m_data_end };
+					const std::size_t found = find_delimiter(data, m_sentinental, search_from);
+					if (found != std::string_view::npos)
+					{
+						m_line_begin = m_next_line_begin;
+						m_line_end = found;
+						m_next_line_begin = m_line_end + 1;
+						return true;
+					}
+					if (m_stream_exhausted)
+					{
+						m_line_begin = m_next_line_begin;
+						m_line_end = m_data_end;
+						m_next_line_begin = m_data_end;
+						m_finished = true;
+						return true;
+					}
+					const std::size_t num_searched = m_data_end - m_next_line_begin;
+					refill();
+					search_from = num_searched;
+				}
+			}
+
+			std::string_view current() const noexcept
+			{
+				return std::string_view{ m_buffer.data() + m_line_begin, m_line_end - m_line_begin };
+			}
+		};
+	}
+
+	// Yields the same lines as istream_line_iterator, but as views into a shared buffer instead of a copy each.
+	// A view is only valid until the iterator is next incremented, and the stream is read ahead so
+	// don't use it for anything else afterwards.
+	class buffered_istream_line_iterator
+	{
+		istream_iterator::line_buffer* m_buffer;
+	public:
+		using pointer = const std::string_view*;
+		using reference = std::string_view;
+		using value_type = std::string_view;
+		using difference_type = int;
+		using iterator_category = std::input_iterator_tag;
+		explicit buffered_istream_line_iterator(istream_iterator::line_buffer& buffer) : m_buffer{ &buffer }
+		{
+			++(*this);
+		}
+		buffered_istream_line_iterator() noexcept : m_buffer{ nullptr } {}
+
+		bool operator==(const buffered_istream_line_iterator& other) const noexcept
+		{
+			return m_buffer == nullptr && other.m_buffer == nullptr;
+		}
+
+		std::string_view operator*() const
+		{
+			if (m_buffer == nullptr)
+			{
+				throw std::range_error{ "Cannot dereference buffered_istream_line_iterator with no present value. This is probably past the end" };
+			}
+			return m_buffer->current();
+		}
+
+		buffered_istream_line_iterator& operator++()
+		{
+			if (m_buffer != nullptr && !m_buffer->advance())
+			{
+				m_buffer = nullptr;
+			}
+			return *this;
+		}
+
+		buffered_istream_line_iterator operator++(int)
+		{
+			auto result = *this;
+			++(*this);
+			return result;
+		}
+	};
+
+	class buffered_istream_line_range
+	{
+		std::unique_ptr<istream_iterator::line_buffer> m_buffer;
+	public:
+		explicit buffered_istream_line_range(std::istream& input, char splitter = '\n', std::size_t chunk_size = istream_iterator::line_buffer::DEFAULT_CHUNK_SIZE)
+			: m_buffer{ std::make_unique<istream_iterator::line_buffer>(input, splitter, chunk_size) } {}
+		buffered_istream_line_range() = delete;
+		buffered_istream_line_range(const buffered_istream_line_range&) = delete;
+		buffered_istream_line_range& operator=(const buffered_istream_line_range&) = delete;
+		buffered_istream_line_range(buffered_istream_line_range&&) noexcept = default;
+		buffered_istream_line_range& operator=(buffered_istream_line_range&&) noexcept = default;
+		buffered_istream_line_iterator begin() const { return buffered_istream_line_iterator{ *m_buffer }; }
+		buffered_istream_line_iterator end() const { return buffered_istream_line_iterator{}; }
+	};
 }
 
 template <utils::istream_iterator::blank_line_behaviour blank_lines>
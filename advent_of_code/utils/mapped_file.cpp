@@ -0,0 +1,172 @@
+#include "mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+utils::mapped_file::mapped_file(const std::filesystem::path& path)
+{
+	if (try_map(path)) return;
+	try_read(path);
+}
+
+utils::mapped_file::~mapped_file()
+{
+	release();
+}
+
+utils::mapped_file::mapped_file(mapped_file&& other) noexcept
+{
+	take(other);
+}
+
+utils::mapped_file& utils::mapped_file::operator=(mapped_file&& other) noexcept
+{
+	if (this != &other)
+	{
+		release();
+		take(other);
+	}
+	return *this;
+}
+
+#ifdef _WIN32
+bool utils::mapped_file::try_map(const std::filesystem::path& path) noexcept
+{
+	HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+
+	LARGE_INTEGER file_size{};
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (mapping == nullptr)
+	{
+		CloseHandle(file);
+		return false;
+	}
+
+	const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+	if (data == nullptr)
+	{
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return false;
+	}
+
+	m_file_handle = file;
+	m_mapping_handle = mapping;
+	m_data = static_cast<const char*>(data);
+	m_size = static_cast<std::size_t>(file_size.QuadPart);
+	m_is_mapped = true;
+	return true;
+}
+
+void utils::mapped_file::release() noexcept
+{
+	if (m_is_mapped)
+	{
+		UnmapViewOfFile(m_data);
+		CloseHandle(m_mapping_handle);
+		CloseHandle(m_file_handle);
+	}
+	m_file_handle = nullptr;
+	m_mapping_handle = nullptr;
+	m_data = nullptr;
+	m_size = 0;
+	m_is_mapped = false;
+	m_fallback_buffer.clear();
+}
+#else
+bool utils::mapped_file::try_map(const std::filesystem::path& path) noexcept
+{
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) return false;
+
+	struct stat file_stats{};
+	if (fstat(fd, &file_stats) != 0 || file_stats.st_size <= 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	const std::size_t size = static_cast<std::size_t>(file_stats.st_size);
+	void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping keeps the file alive by itself.
+	close(fd);
+	if (data == MAP_FAILED) return false;
+
+	// Puzzles read the input front to back, so ask for aggressive readahead.
+	madvise(data, size, MADV_SEQUENTIAL);
+
+	m_data = static_cast<const char*>(data);
+	m_size = size;
+	m_is_mapped = true;
+	return true;
+}
+
+void utils::mapped_file::release() noexcept
+{
+	if (m_is_mapped)
+	{
+		munmap(const_cast<char*>(m_data), m_size);
+	}
+	m_data = nullptr;
+	m_size = 0;
+	m_is_mapped = false;
+	m_fallback_buffer.clear();
+}
+#endif
+
+bool utils::mapped_file::try_read(const std::filesystem::path& path)
+{
+	std::ifstream file{ path, std::ios::binary };
+	if (!file.is_open()) return false;
+	m_fallback_buffer.assign(std::istreambuf_iterator<char>{ file }, std::istreambuf_iterator<char>{});
+	m_data = m_fallback_buffer.data();
+	m_size = m_fallback_buffer.size();
+	m_is_mapped = false;
+	return true;
+}
+
+void utils::mapped_file::take(mapped_file& other) noexcept
+{
+	m_is_mapped = other.m_is_mapped;
+	m_size = other.m_size;
+#ifdef _WIN32
+	m_file_handle = other.m_file_handle;
+	m_mapping_handle = other.m_mapping_handle;
+	other.m_file_handle = nullptr;
+	other.m_mapping_handle = nullptr;
+#endif
+	if (m_is_mapped)
+	{
+		m_data = other.m_data;
+	}
+	else
+	{
+		// The buffer may be using the small string optimisation, so the pointer has to be taken again after moving it.
+		const bool other_is_open = other.is_open();
+		m_fallback_buffer = std::move(other.m_fallback_buffer);
+		m_data = other_is_open ? m_fallback_buffer.data() : nullptr;
+	}
+	other.m_data = nullptr;
+	other.m_size = 0;
+	other.m_is_mapped = false;
+	other.m_fallback_buffer.clear();
+}
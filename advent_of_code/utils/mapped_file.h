@@ -0,0 +1,42 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <filesystem>
+
+namespace utils
+{
+	// A read-only view of a whole file. The file is memory-mapped so nothing gets copied,
+	// and split with utils::string_line_range (or anything else that takes a std::string_view) without copying either.
+	// If the file can't be mapped (e.g. it's empty) the contents are read into memory instead.
+	// Note that, unlike a text mode std::ifstream, this does not translate "\r\n" line endings.
+	class mapped_file
+	{
+		const char* m_data = nullptr;
+		std::size_t m_size = 0;
+		bool m_is_mapped = false;
+		std::string m_fallback_buffer;
+#ifdef _WIN32
+		void* m_file_handle = nullptr;
+		void* m_mapping_handle = nullptr;
+#endif
+		bool try_map(const std::filesystem::path& path) noexcept;
+		bool try_read(const std::filesystem::path& path);
+		void release() noexcept;
+		void take(mapped_file& other) noexcept;
+	public:
+		mapped_file() noexcept = default;
+		explicit mapped_file(const std::filesystem::path& path);
+		~mapped_file();
+		mapped_file(mapped_file&& other) noexcept;
+		mapped_file& operator=(mapped_file&& other) noexcept;
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		bool is_open() const noexcept { return m_data != nullptr; }
+		bool is_mapped() const noexcept { return m_is_mapped; }
+		std::string_view view() const noexcept { return std::string_view{ m_data, m_size }; }
+		operator std::string_view() const noexcept { return view(); }
+		std::size_t size() const noexcept { return m_size; }
+	};
+}
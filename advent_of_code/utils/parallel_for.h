@@ -0,0 +1,149 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#include <optional>
+#include <concepts>
+#include <utility>
+
+namespace utils
+{
+	namespace parallel_for_internal
+	{
+		// A contiguous block of task indices. The owning thread takes tasks from the front,
+		// and threads that have run out of work steal half of what is left from the back.
+		class task_block
+		{
+			mutable std::mutex m_mutex;
+			std::size_t m_front = 0;
+			std::size_t m_back = 0;
+		public:
+			void reset(std::size_t front, std::size_t back)
+			{
+				std::scoped_lock lock{ m_mutex };
+				m_front = front;
+				m_back = back;
+			}
+
+			std::optional<std::size_t> pop_front()
+			{
+				std::scoped_lock lock{ m_mutex };
+				if (m_front == m_back) return std::nullopt;
+				return m_front++;
+			}
+
+			// Rounds up, so a single remaining task can still be stolen.
+			std::pair<std::size_t, std::size_t> steal_back_half()
+			{
+				std::scoped_lock lock{ m_mutex };
+				const std::size_t remaining = m_back - m_front;
+				const std::size_t num_stolen = remaining - remaining / 2;
+				m_back -= num_stolen;
+				return std::pair{ m_back, m_back + num_stolen };
+			}
+
+			std::size_t size() const
+			{
+				std::scoped_lock lock{ m_mutex };
+				return m_back - m_front;
+			}
+		};
+
+		// Set while a thread is running tasks for a parallel_for that uses more than one thread.
+		inline thread_local bool is_in_worker = false;
+
+		class worker_scope
+		{
+			bool m_was_in_worker = false;
+		public:
+			worker_scope() : m_was_in_worker{ std::exchange(is_in_worker, true) } {}
+			~worker_scope() { is_in_worker = m_was_in_worker; }
+			worker_scope(const worker_scope&) = delete;
+			worker_scope& operator=(const worker_scope&) = delete;
+		};
+	}
+
+	// Zero means "use every core", unless this is already one of several parallel_for threads
+	// (e.g. a test run with --jobs), in which case the cores are already busy and it means one thread.
+	inline std::size_t get_num_worker_threads(std::size_t requested)
+	{
+		if (requested != 0) return requested;
+		if (parallel_for_internal::is_in_worker) return 1;
+		return std::max(std::size_t{ std::thread::hardware_concurrency() }, std::size_t{ 1 });
+	}
+
+	// Calls func(i) for every i in [0,num_tasks) spread over num_threads threads, including the calling one.
+	// Each thread starts with an equal block of indices and steals from the fullest block when its own is empty,
+	// so a few slow tasks don't leave the other threads idle. With one thread the tasks run in order on the calling thread.
+	// If any task throws, the first exception is rethrown once every thread has finished.
+	// A parallel_for started from inside one of the tasks defaults to running on its own thread (see get_num_worker_threads).
+	template <typename Func> requires std::invocable<Func&, std::size_t>
+	void parallel_for(std::size_t num_tasks, Func func, std::size_t num_threads = 0)
+	{
+		num_threads = std::min(get_num_worker_threads(num_threads), num_tasks);
+		if (num_threads <= 1)
+		{
+			for (std::size_t i = 0; i < num_tasks; ++i)
+			{
+				func(i);
+			}
+			return;
+		}
+
+		using parallel_for_internal::task_block;
+		std::vector<task_block> blocks(num_threads);
+		for (std::size_t t = 0; t < num_threads; ++t)
+		{
+			blocks[t].reset(num_tasks * t / num_threads, num_tasks * (t + 1) / num_threads);
+		}
+
+		std::mutex error_mutex;
+		std::exception_ptr first_error;
+
+		auto worker = [&blocks, &func, &error_mutex, &first_error](std::size_t thread_idx)
+			{
+				const parallel_for_internal::worker_scope scope;
+				task_block& own_block = blocks[thread_idx];
+				while (true)
+				{
+					if (const auto task = own_block.pop_front())
+					{
+						try
+						{
+							func(*task);
+						}
+						catch (...)
+						{
+							std::scoped_lock lock{ error_mutex };
+							if (!first_error) first_error = std::current_exception();
+						}
+						continue;
+					}
+
+					// A thief always runs what it steals, so if every block looks empty there is nothing left for us.
+					const auto victim = std::ranges::max_element(blocks, {}, &task_block::size);
+					if (victim->size() == 0) return;
+					const auto [first, last] = victim->steal_back_half();
+					own_block.reset(first, last);
+				}
+			};
+
+		{
+			std::vector<std::jthread> threads;
+			threads.reserve(num_threads - 1);
+			for (std::size_t t = 1; t < num_threads; ++t)
+			{
+				threads.emplace_back(worker, t);
+			}
+			worker(0);
+		}
+
+		if (first_error)
+		{
+			std::rethrow_exception(first_error);
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "parallel_for.h"
+#include "find_delimiters.h"
+
+#include <string>
+#include <string_view>
+#include <istream>
+#include <iterator>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <concepts>
+#include <utility>
+#include <algorithm>
+
+namespace utils
+{
+	// For puzzles where the answer combines independent answers for each line.
+	// The input gets split into lines up front, then batches of lines are transformed across several threads
+	// (see parallel_for), and finally the results are folded into init with reduce, in line order.
+	// Empty lines (e.g. the one after the final newline) are skipped.
+	// num_threads works as in parallel_for: 0 means every core, or just this thread if this is already
+	// one of parallel_for's worker threads (e.g. when tests run with --jobs), so the cores aren't oversubscribed.
+	template <typename T, typename Transform, typename Reduce = std::plus<T>>
+		requires std::invocable<Transform&, std::string_view>
+	T parallel_transform_reduce_lines(std::string_view input, T init, Transform transform, Reduce reduce = Reduce{}, std::size_t num_threads = 0)
+	{
+		constexpr std::size_t BATCHES_PER_THREAD = 8;
+
+		std::vector<std::size_t> line_ends;
+		find_delimiters(input, '\n', line_ends);
+		line_ends.push_back(input.size());
+
+		const std::size_t num_lines = line_ends.size();
+		num_threads = get_num_worker_threads(num_threads);
+		const std::size_t num_batches = std::min(num_lines, num_threads * BATCHES_PER_THREAD);
+		const std::size_t lines_per_batch = (num_lines + num_batches - 1) / num_batches;
+
+		std::vector<std::optional<T>> partial_results(num_batches);
+		auto run_batch = [&](std::size_t batch_idx)
+			{
+				std::optional<T>& partial = partial_results[batch_idx];
+				const std::size_t first_line = batch_idx * lines_per_batch;
+				const std::size_t last_line = std::min(num_lines, first_line + lines_per_batch);
+				for (std::size_t line_idx = first_line; line_idx < last_line; ++line_idx)
+				{
+					const std::size_t line_start = line_idx == 0 ? 0 : line_ends[line_idx - 1] + 1;
+					const std::string_view line = input.substr(line_start, line_ends[line_idx] - line_start);
+					if (line.empty()) continue;
+					T result = transform(line);
+					partial = partial.has_value() ? reduce(std::move(*partial), std::move(result)) : std::move(result);
+				}
+			};
+		parallel_for(num_batches, run_batch, num_threads);
+
+		for (std::optional<T>& partial : partial_results)
+		{
+			if (partial.has_value())
+			{
+				init = reduce(std::move(init), std::move(*partial));
+			}
+		}
+		return init;
+	}
+
+	// Reads the rest of the stream first, so worker threads never wait on it.
+	template <typename T, typename Transform, typename Reduce = std::plus<T>>
+		requires std::invocable<Transform&, std::string_view>
+	T parallel_transform_reduce_lines(std::istream& input, T init, Transform transform, Reduce reduce = Reduce{}, std::size_t num_threads = 0)
+	{
+		const std::string contents{ std::istreambuf_iterator<char>{ input }, std::istreambuf_iterator<char>{} };
+		return parallel_transform_reduce_lines(std::string_view{ contents }, std::move(init), std::move(transform), std::move(reduce), num_threads);
+	}
+}
@@ -5,6 +5,8 @@
 #include <numeric>
 #include <array>
 
+#include "find_delimiters.h"
+
 namespace utils
 {
 	[[nodiscard]] inline std::pair<std::string_view, std::string_view> split_string_at_point(std::string_view str, std::size_t split_point)
@@ -21,7 +23,7 @@ namespace utils
 
 	[[nodiscard]] inline std::pair<std::string_view, std::string_view> split_string_at_first(std::string_view str, std::string_view delim)
 	{
-		const auto split_point = str.find(delim);
+		const auto split_point = delim.size() == 1 ? find_delimiter(str, delim.front()) : str.find(delim);
 		if (split_point < str.size())
 		{
 			const std::string_view left = str.substr(0, split_point);
@@ -70,9 +72,24 @@ namespace utils
 		return result;
 	}
 
+	// Same result as the std::string_view version, but finds every delimiter in one pass first.
 	[[nodiscard]] inline std::vector<std::string_view> split_string(std::string_view str, char delim)
 	{
-		return split_string(str, std::string_view{ &delim,1 });
+		std::vector<std::size_t> delimiters;
+		find_delimiters(str, delim, delimiters);
+		std::vector<std::string_view> result;
+		result.reserve(delimiters.size() + 1);
+		std::size_t start = 0;
+		for (std::size_t delimiter : delimiters)
+		{
+			result.push_back(str.substr(start, delimiter - start));
+			start = delimiter + 1;
+		}
+		if (start < str.size())
+		{
+			result.push_back(str.substr(start));
+		}
+		return result;
 	}
 
 	[[nodiscard]] inline std::vector<std::string_view> split_string(std::string_view str)
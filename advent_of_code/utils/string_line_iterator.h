@@ -22,8 +22,16 @@ namespace utils
 		std::string_view m_string;
 		std::string_view m_sentinental;
 		char m_sentinental_storage;
+		bool m_uses_sentinental_storage;
 		trim_behaviour m_trim_behaviour;
 		mutable std::optional<std::pair<std::string_view,std::string_view>> m_cached_split_result;
+
+		// A single char sentinental lives inside this object, so it has to be looked up here rather than
+		// stored as a view, which would dangle as soon as the iterator gets copied.
+		std::string_view get_sentinental() const noexcept
+		{
+			return m_uses_sentinental_storage ? std::string_view{ &m_sentinental_storage,1 } : m_sentinental;
+		}
 		std::pair<std::string_view, std::string_view> get_split_result() const
 		{
 			if (is_at_end())
@@ -33,7 +41,7 @@ namespace utils
 
 			if (!m_cached_split_result.has_value())
 			{
-				m_cached_split_result = utils::split_string_at_first(m_string,m_sentinental);
+				m_cached_split_result = utils::split_string_at_first(m_string,get_sentinental());
 			}
 
 			AdventCheck(m_cached_split_result.has_value());
@@ -55,14 +63,15 @@ namespace utils
 		using difference_type = int;
 		using iterator_category = std::forward_iterator_tag;
 		string_line_iterator(std::string_view string_to_split, std::string_view sentinental, trim_behaviour behaviour) noexcept
-			: m_string{string_to_split}, m_sentinental{sentinental}, m_sentinental_storage{'\0'}, m_trim_behaviour{behaviour}
+			: m_string{string_to_split}, m_sentinental{sentinental}, m_sentinental_storage{'\0'}, m_uses_sentinental_storage{false}, m_trim_behaviour{behaviour}
 		{
 			m_string = try_trim(m_string);
 		}
 		string_line_iterator(std::string_view string_to_split, char sentinental, trim_behaviour behaviour) noexcept
-			: string_line_iterator{string_to_split, std::string_view{&m_sentinental_storage,1}, behaviour}
+			: string_line_iterator{string_to_split, std::string_view{}, behaviour}
 		{
 			m_sentinental_storage = sentinental;
+			m_uses_sentinental_storage = true;
 		}
 		string_line_iterator(std::string_view string_to_split, std::string_view sentinental) noexcept
 			: string_line_iterator{ string_to_split , sentinental , trim_behaviour::trim_before_incrementing }{}
@@ -121,15 +130,13 @@ namespace utils
 		std::string_view m_string;
 		std::string_view m_sentinental;
 		char m_sentinental_storage = '\0';
+		bool m_uses_sentinental_storage = false;
 		string_line_iterator::trim_behaviour m_trim_behaviour;
 	public:
 		string_line_range(std::string_view string_to_split, std::string_view sentinental, string_line_iterator::trim_behaviour behaviour) noexcept
-			: m_string{ string_to_split }, m_sentinental{ sentinental }, m_sentinental_storage{ '\0' }, m_trim_behaviour{ behaviour } {}
+			: m_string{ string_to_split }, m_sentinental{ sentinental }, m_sentinental_storage{ '\0' }, m_uses_sentinental_storage{ false }, m_trim_behaviour{ behaviour } {}
 		string_line_range(std::string_view string_to_split, char sentinental, string_line_iterator::trim_behaviour behaviour) noexcept
-			: string_line_range{ string_to_split, std::string_view{&m_sentinental_storage,1}, behaviour }
-		{
-			m_sentinental_storage = sentinental;
-		}
+			: m_string{ string_to_split }, m_sentinental{}, m_sentinental_storage{ sentinental }, m_uses_sentinental_storage{ true }, m_trim_behaviour{ behaviour } {}
 		string_line_range(std::string_view string_to_split, std::string_view sentinental) noexcept
 			: string_line_range{ string_to_split , sentinental , string_line_iterator::trim_behaviour::trim_before_incrementing } {}
 		string_line_range(std::string_view string_to_split, char sentinental) noexcept
@@ -140,7 +147,14 @@ namespace utils
 			: string_line_range{ string_to_split, string_line_iterator::trim_behaviour::trim_before_incrementing } {}
 		string_line_range(const string_line_range& other) noexcept = default;
 		string_line_range() = delete;
-		string_line_iterator begin() const noexcept { return string_line_iterator{ m_string ,m_sentinental }; }
+		string_line_iterator begin() const noexcept
+		{
+			if (m_uses_sentinental_storage)
+			{
+				return string_line_iterator{ m_string, m_sentinental_storage };
+			}
+			return string_line_iterator{ m_string, m_sentinental };
+		}
 		string_line_iterator end() const noexcept { return string_line_iterator{}; }
 	};
 }
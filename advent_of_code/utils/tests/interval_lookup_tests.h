@@ -0,0 +1,9 @@
+#pragma once
+
+#include "utils/tests/utils_tests.h"
+
+DECLARE_UTILS_TEST("interval_lookup - empty set", interval_lookup_empty_set, "0 [0,0,0]");
+DECLARE_UTILS_TEST("interval_lookup - intervals at the ends of the type's range", interval_lookup_type_limits, "[1,1,0,1,1,0]");
+DECLARE_UTILS_TEST("interval_lookup - matches interval_set on random uint64_t data", interval_lookup_random_uint64, "ok");
+DECLARE_UTILS_TEST("interval_lookup - matches interval_set on random int64_t data", interval_lookup_random_int64, "ok");
+DECLARE_UTILS_TEST("interval_lookup - matches interval_set on random int32_t data", interval_lookup_random_int32, "ok");
\ No newline at end of file
@@ -0,0 +1,12 @@
+#pragma once
+
+#include "utils/tests/utils_tests.h"
+
+DECLARE_UTILS_TEST("interval_set - touching intervals merge", interval_set_touching_merge, "[[1,5)]");
+DECLARE_UTILS_TEST("interval_set - overlapping and nested intervals merge", interval_set_overlapping_merge, "[[0,6),[10,12)]");
+DECLARE_UTILS_TEST("interval_set - a gap of one keeps intervals apart", interval_set_gap_kept, "[[1,3),[4,5)]");
+DECLARE_UTILS_TEST("interval_set - empty insert is a no-op", interval_set_empty_insert, "[[1,5),[6,8)] contains(5)=0");
+DECLARE_UTILS_TEST("interval_set - contains at the boundaries", interval_set_contains_boundaries, "[0,1,1,0,0,1]");
+DECLARE_UTILS_TEST("interval_set - count_contained with duplicates and values past the end", interval_set_count_contained, "7");
+DECLARE_UTILS_TEST("interval_set - total_size counts overlaps once", interval_set_total_size, "[9,8]");
+DECLARE_UTILS_TEST("interval_set - inserting after a query", interval_set_insert_after_query, "[[0,6)] contains(5)=1");
\ No newline at end of file
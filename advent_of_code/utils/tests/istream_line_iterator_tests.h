@@ -0,0 +1,11 @@
+#pragma once
+
+#include "utils/tests/utils_tests.h"
+
+DECLARE_UTILS_TEST("buffered_istream_line_range - line split across a chunk boundary", buffered_istream_line_range_split_across_chunks, "['abc','defgh','ij']");
+DECLARE_UTILS_TEST("buffered_istream_line_range - line longer than a chunk", buffered_istream_line_range_line_longer_than_chunk, "['abcdefghij','k','lmnopqrstuvwxyz']");
+DECLARE_UTILS_TEST("buffered_istream_line_range - no trailing newline", buffered_istream_line_range_no_trailing_newline, "['ab','cd']");
+DECLARE_UTILS_TEST("buffered_istream_line_range - trailing newline", buffered_istream_line_range_trailing_newline, "['ab','cd','']");
+DECLARE_UTILS_TEST("buffered_istream_line_range - CRLF line endings", buffered_istream_line_range_crlf, "['ab\\r','','cd\\r','']");
+DECLARE_UTILS_TEST("buffered_istream_line_range - empty stream", buffered_istream_line_range_empty_stream, "['']");
+DECLARE_UTILS_TEST("buffered_istream_line_range - every chunk size matches std::getline", buffered_istream_line_range_all_chunk_sizes, "ok");
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "utils/tests/interval_lookup_tests.h"
+
+#if UTILS_TESTING
+
+#include "utils/interval_lookup.h"
+#include "utils/interval_set.h"
+
+#include <string>
+#include <vector>
+#include <random>
+#include <limits>
+#include <cstdint>
+
+namespace
+{
+	template <std::integral T>
+	std::string print_contains(const utils::interval_lookup<T>& lookup, const std::vector<T>& values)
+	{
+		std::vector<int> results;
+		for (T value : values)
+		{
+			results.push_back(lookup.contains(value) ? 1 : 0);
+		}
+		return utils::testing::print_container(results);
+	}
+
+	// Tree sizes either side of each power of two, since the tree is padded out to the next one.
+	// Batch sizes include ones that aren't a multiple of the eight searches count_contained runs at once.
+	template <std::integral T>
+	ResultType check_against_interval_set(uint64_t seed)
+	{
+		constexpr T MIN = std::numeric_limits<T>::min();
+		constexpr T MAX = std::numeric_limits<T>::max();
+		std::mt19937_64 rng{ seed };
+		std::uniform_int_distribution<T> small_value{ static_cast<T>(-100000 * std::is_signed_v<T>), T{ 100000 } };
+		auto random_value = [&rng, &small_value]() -> T
+			{
+				switch (rng() % 8)
+				{
+				case 0: return MIN + static_cast<T>(rng() % 4);
+				case 1: return MAX - static_cast<T>(rng() % 4);
+				default: return small_value(rng);
+				}
+			};
+
+		const std::vector<std::size_t> num_intervals_list{ 0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 31, 32, 33, 100 };
+		const std::vector<std::size_t> batch_sizes{ 0, 1, 7, 8, 9, 15, 16, 17, 1003 };
+		for (std::size_t num_intervals : num_intervals_list)
+		{
+			utils::interval_set<T> set;
+			while (set.size() < num_intervals)
+			{
+				// Keep the intervals short, so the lookup ends up with lots of separate ones.
+				const T first = random_value();
+				const T length = static_cast<T>(rng() % 50);
+				set.insert(first, first <= MAX - length ? first + length : MAX);
+			}
+			const utils::interval_lookup<T> lookup{ set };
+
+			for (std::size_t batch_size : batch_sizes)
+			{
+				std::vector<T> values(batch_size);
+				for (T& value : values)
+				{
+					value = random_value();
+				}
+				values.push_back(MIN);
+				values.push_back(MAX);
+				const std::size_t expected = set.count_contained(values);
+				const std::size_t result = lookup.count_contained(values);
+				if (result != expected)
+				{
+					return "Mismatch with " + std::to_string(set.size()) + " intervals and " + std::to_string(values.size())
+						+ " values: got " + std::to_string(result) + ", expected " + std::to_string(expected);
+				}
+				for (T value : values)
+				{
+					if (lookup.contains(value) != set.contains(value))
+					{
+						return "contains mismatch for " + std::to_string(value) + " with " + std::to_string(set.size()) + " intervals";
+					}
+				}
+			}
+		}
+		return "ok";
+	}
+}
+
+ResultType interval_lookup_empty_set()
+{
+	const utils::interval_lookup<int64_t> lookup{ utils::interval_set<int64_t>{} };
+	const std::vector<int64_t> values{ std::numeric_limits<int64_t>::min(), 0, std::numeric_limits<int64_t>::max() };
+	return std::to_string(lookup.count_contained(values)) + ' ' + print_contains(lookup, values);
+}
+
+// The padding entries use the type's maximum, so an interval running right up to it mustn't get mixed up with them.
+ResultType interval_lookup_type_limits()
+{
+	constexpr uint64_t MAX = std::numeric_limits<uint64_t>::max();
+	utils::interval_set<uint64_t> set;
+	set.insert(0, 2);
+	set.insert(MAX - 2, MAX);
+	const utils::interval_lookup<uint64_t> lookup{ set };
+	return print_contains(lookup, std::vector<uint64_t>{ 0, 1, 2, MAX - 2, MAX - 1, MAX });
+}
+
+ResultType interval_lookup_random_uint64()
+{
+	return check_against_interval_set<uint64_t>(1);
+}
+
+ResultType interval_lookup_random_int64()
+{
+	return check_against_interval_set<int64_t>(2);
+}
+
+ResultType interval_lookup_random_int32()
+{
+	return check_against_interval_set<int32_t>(3);
+}
+
+#endif
\ No newline at end of file
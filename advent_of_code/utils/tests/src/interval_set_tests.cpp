@@ -0,0 +1,97 @@
+#include "utils/tests/interval_set_tests.h"
+
+#if UTILS_TESTING
+
+#include "utils/interval_set.h"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <initializer_list>
+#include <utility>
+
+namespace
+{
+	template <std::integral T>
+	std::string print_intervals(const utils::interval_set<T>& set)
+	{
+		std::vector<std::string> intervals;
+		for (const auto& [first, last] : set)
+		{
+			intervals.push_back('[' + std::to_string(first) + ',' + std::to_string(last) + ')');
+		}
+		return utils::testing::print_container(intervals);
+	}
+
+	template <std::integral T>
+	utils::interval_set<T> make_set(std::initializer_list<std::pair<T, T>> intervals)
+	{
+		utils::interval_set<T> result;
+		for (const auto& interval : intervals)
+		{
+			result.insert(interval);
+		}
+		return result;
+	}
+}
+
+ResultType interval_set_touching_merge()
+{
+	return print_intervals(make_set<int>({ { 3,5 }, { 1,3 } }));
+}
+
+ResultType interval_set_overlapping_merge()
+{
+	return print_intervals(make_set<int>({ { 2,6 }, { 10,12 }, { 0,2 }, { 1,4 }, { 11,12 }, { 3,4 } }));
+}
+
+ResultType interval_set_gap_kept()
+{
+	return print_intervals(make_set<int>({ { 4,5 }, { 1,3 } }));
+}
+
+// Inserting [5,5) between [1,5) and [6,8) mustn't add 5 or join them up.
+ResultType interval_set_empty_insert()
+{
+	utils::interval_set<int> set = make_set<int>({ { 1,5 }, { 6,8 } });
+	set.insert(5, 5);
+	set.insert(100, 100);
+	return print_intervals(set) + " contains(5)=" + std::to_string(set.contains(5));
+}
+
+ResultType interval_set_contains_boundaries()
+{
+	const utils::interval_set<int64_t> set = make_set<int64_t>({ { 10,20 }, { -5,-3 } });
+	std::vector<int> results;
+	for (int64_t value : { int64_t{ 9 }, int64_t{ 10 }, int64_t{ 19 }, int64_t{ 20 }, int64_t{ -6 }, int64_t{ -5 } })
+	{
+		results.push_back(set.contains(value) ? 1 : 0);
+	}
+	return utils::testing::print_container(results);
+}
+
+ResultType interval_set_count_contained()
+{
+	const utils::interval_set<uint64_t> set = make_set<uint64_t>({ { 10,15 }, { 0,5 } });
+	return set.count_contained({ 14, 0, 4, 5, 9, 10, 0, 14, 15, 100, 3 });
+}
+
+ResultType interval_set_total_size()
+{
+	const utils::interval_set<uint64_t> unsigned_set = make_set<uint64_t>({ { 0,5 }, { 3,8 }, { 10,11 } });
+	const utils::interval_set<int> signed_set = make_set<int>({ { -5,-1 }, { -2,3 } });
+	return utils::testing::print_container(std::vector<int64_t>{ static_cast<int64_t>(unsigned_set.total_size()), signed_set.total_size() });
+}
+
+// The first query merges what's there. Later inserts have to be merged in again before the next query.
+ResultType interval_set_insert_after_query()
+{
+	utils::interval_set<int> set;
+	set.insert(1, 3);
+	AdventCheck(set.contains(2));
+	set.insert(3, 6);
+	set.insert(0, 1);
+	return print_intervals(set) + " contains(5)=" + std::to_string(set.contains(5));
+}
+
+#endif
\ No newline at end of file
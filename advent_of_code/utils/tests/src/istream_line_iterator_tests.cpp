@@ -0,0 +1,114 @@
+#include "utils/tests/istream_line_iterator_tests.h"
+
+#if UTILS_TESTING
+
+#include "utils/istream_line_iterator.h"
+
+#include <string>
+#include <string_view>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+	// Quoted, with any '\r' written out so it shows up in the results.
+	std::string describe_line(std::string_view line)
+	{
+		std::string result{ '\'' };
+		for (char c : line)
+		{
+			if (c == '\r')
+			{
+				result += "\\r";
+			}
+			else
+			{
+				result += c;
+			}
+		}
+		result += '\'';
+		return result;
+	}
+
+	std::vector<std::string> get_lines_by_getline(std::string_view input)
+	{
+		std::istringstream stream{ std::string{ input } };
+		std::vector<std::string> result;
+		for (std::string_view line : utils::istream_line_range{ stream })
+		{
+			result.push_back(describe_line(line));
+		}
+		return result;
+	}
+
+	std::vector<std::string> get_buffered_lines(std::string_view input, std::size_t chunk_size)
+	{
+		std::istringstream stream{ std::string{ input } };
+		std::vector<std::string> result;
+		for (std::string_view line : utils::buffered_istream_line_range{ stream, '\n', chunk_size })
+		{
+			result.push_back(describe_line(line));
+		}
+		return result;
+	}
+
+	// The buffered range should always agree with istream_line_range, which just calls std::getline.
+	ResultType test_buffered_lines(std::string_view input, std::size_t chunk_size)
+	{
+		const std::vector<std::string> lines = get_buffered_lines(input, chunk_size);
+		if (lines != get_lines_by_getline(input))
+		{
+			return "Mismatch with istream_line_range: " + utils::testing::print_container(lines);
+		}
+		return utils::testing::print_container(lines);
+	}
+}
+
+// The first chunk is "abc\nde", so "defgh" has to be moved to the front of the buffer and finished from the next read.
+ResultType buffered_istream_line_range_split_across_chunks()
+{
+	return test_buffered_lines("abc\ndefgh\nij", 6);
+}
+
+// The buffer has to grow (twice for the last line) to hold lines bigger than the chunk size.
+ResultType buffered_istream_line_range_line_longer_than_chunk()
+{
+	return test_buffered_lines("abcdefghij\nk\nlmnopqrstuvwxyz", 4);
+}
+
+ResultType buffered_istream_line_range_no_trailing_newline()
+{
+	return test_buffered_lines("ab\ncd", 3);
+}
+
+// Like std::getline, the text after the final newline is an empty line.
+ResultType buffered_istream_line_range_trailing_newline()
+{
+	return test_buffered_lines("ab\ncd\n", 3);
+}
+
+// Only '\n' splits lines, so each '\r' stays on the end of its line. A chunk size of 3 splits the first "\r\n".
+ResultType buffered_istream_line_range_crlf()
+{
+	return test_buffered_lines("ab\r\n\ncd\r\n", 3);
+}
+
+ResultType buffered_istream_line_range_empty_stream()
+{
+	return test_buffered_lines("", 4);
+}
+
+ResultType buffered_istream_line_range_all_chunk_sizes()
+{
+	constexpr std::string_view input = "first line\n\nx\r\na much longer line than the rest of them\n\n\nlast";
+	for (std::size_t chunk_size = 1; chunk_size <= input.size() + 1; ++chunk_size)
+	{
+		if (get_buffered_lines(input, chunk_size) != get_lines_by_getline(input))
+		{
+			return "Mismatch with chunk size " + std::to_string(chunk_size);
+		}
+	}
+	return "ok";
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,36 @@
+#include "utils/tests/string_line_iterator_tests.h"
+
+#if UTILS_TESTING
+
+#include "utils/string_line_iterator.h"
+
+#include <optional>
+#include <ranges>
+
+// A single char delimiter is kept inside the iterator or range itself. The first two tests reuse the original's storage
+// for something with a different delimiter, so a copy still looking at the original would split at the wrong place.
+
+ResultType string_line_iterator_copy_keeps_char_delimiter()
+{
+	std::optional<utils::string_line_iterator> original{ std::in_place, "a|b|c", '|' };
+	const utils::string_line_iterator copy = *original;
+	original.emplace("x;y", ';');
+	return utils::testing::print_container(std::ranges::subrange{ copy, utils::string_line_iterator{} });
+}
+
+ResultType string_line_range_copy_keeps_char_delimiter()
+{
+	std::optional<utils::string_line_range> original{ std::in_place, "a|b|c", '|' };
+	const utils::string_line_range copy = *original;
+	original.emplace("x;y", ';');
+	return utils::testing::print_container(copy);
+}
+
+// Moving the range into the pipeline is what used to leave it reading a dead delimiter.
+ResultType string_line_range_copy_in_view_pipeline()
+{
+	auto lines = utils::string_line_range{ "1|2|3", '|' } | std::views::transform([](std::string_view line) { return line; });
+	return utils::testing::print_container(lines);
+}
+
+#endif
\ No newline at end of file
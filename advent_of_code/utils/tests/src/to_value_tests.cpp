@@ -0,0 +1,142 @@
+#include "utils/tests/to_value_tests.h"
+
+#if UTILS_TESTING
+
+#include "utils/to_value.h"
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <cstring>
+#include <cstdint>
+
+namespace
+{
+	template <std::integral T>
+	std::string parse_and_print(std::string_view input, std::string_view separators)
+	{
+		return utils::testing::print_container(utils::to_values<T>(input, separators));
+	}
+
+	// Copies the input into an allocation of exactly the right size, so reading past the end of it is a real overrun.
+	template <std::integral T>
+	void parse_exact_buffer(std::string_view input, std::string_view separators, std::vector<T>& out)
+	{
+		const auto buffer = std::make_unique<char[]>(input.size());
+		std::memcpy(buffer.get(), input.data(), input.size());
+		utils::to_values<T>(std::string_view{ buffer.get(), input.size() }, separators, out);
+	}
+}
+
+// Covers both SWAR paths (up to 8 digits, and 9-16 as two words) and the from_chars fallback past 16.
+// Each number is checked on its own and with another digit right after it in memory.
+ResultType to_values_all_digit_counts()
+{
+	constexpr std::string_view patterns[] = { "12345678901234567890", "99999999999999999999", "10000000000000000000" };
+	for (std::string_view pattern : patterns)
+	{
+		for (std::size_t num_digits = 1; num_digits <= pattern.size(); ++num_digits)
+		{
+			const std::string_view digits = pattern.substr(0, num_digits);
+			uint64_t expected = 0;
+			bool fits = true;
+			for (char c : digits)
+			{
+				const uint64_t digit = static_cast<uint64_t>(c - '0');
+				fits = fits && expected <= (std::numeric_limits<uint64_t>::max() - digit) / 10;
+				expected = expected * 10 + digit;
+			}
+			if (!fits) continue;
+
+			const std::string padded = std::string{ digits } + "5";
+			for (std::string_view input : { digits, std::string_view{ padded }.substr(0, num_digits) })
+			{
+				const std::vector<uint64_t> values = utils::to_values<uint64_t>(input, "");
+				if (values.size() != 1 || values.front() != expected)
+				{
+					return "Wrong result for '" + std::string{ input } + "': " + utils::testing::print_container(values);
+				}
+			}
+		}
+	}
+	return "ok";
+}
+
+ResultType to_values_uint64_limits()
+{
+	return parse_and_print<uint64_t>("0 18446744073709551615", "");
+}
+
+ResultType to_values_signed()
+{
+	return parse_and_print<int64_t>("-1 -12 +3 -123456789 -9223372036854775808 9223372036854775807", "");
+}
+
+ResultType to_values_int32_limits()
+{
+	return parse_and_print<int32_t>("-2147483648 2147483647", "");
+}
+
+ResultType to_values_ends_at_buffer_end()
+{
+	std::vector<uint64_t> values;
+	for (std::string_view input : { "7", "123", "123456789012" })
+	{
+		parse_exact_buffer(input, "", values);
+	}
+	return utils::testing::print_container(values);
+}
+
+ResultType to_values_view_ends_mid_number()
+{
+	constexpr std::string_view input = "12,3456";
+	return parse_and_print<int>(input.substr(0, 5), ",");
+}
+
+ResultType to_values_separators()
+{
+	return parse_and_print<int64_t>("3-5,10-14\n7", "-,");
+}
+
+// Without '-' as a separator it's a sign, so "3 -5" is 3 and -5. With it, "3-5" is 3 and 5.
+ResultType to_values_sign_or_separator()
+{
+	std::vector<int> values = utils::to_values<int>("3 -5", "");
+	utils::to_values<int>("3-5", "-", values);
+	return utils::testing::print_container(values);
+}
+
+ResultType to_values_separator_runs()
+{
+	return parse_and_print<unsigned>(",,1,, 2\t\r\n\n3,", ",");
+}
+
+// Each of these fails an AdventCheck, so in a debugger this stops at each one before carrying on.
+ResultType to_values_rejects_bad_input()
+{
+	auto check_rejected = []<std::integral T>(std::string_view input, std::string_view separators, T)
+		{
+			try
+			{
+				utils::to_values<T>(input, separators);
+			}
+			catch (const advent::test_failed&)
+			{
+				return std::string{ "rejected" };
+			}
+			return std::string{ "accepted" };
+		};
+
+	const std::vector<std::string> results{
+		check_rejected("1,2,x", ",", int{}),
+		check_rejected("1 -2", "", unsigned{}),
+		check_rejected("1 - 2", "", int{}),
+		check_rejected("256", "", uint8_t{}),
+		check_rejected("2147483648", "", int32_t{}),
+		check_rejected("184467440737095516150", "", uint64_t{})
+	};
+	return utils::testing::print_container(results);
+}
+
+#endif
\ No newline at end of file
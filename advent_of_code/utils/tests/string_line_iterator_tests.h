@@ -0,0 +1,7 @@
+#pragma once
+
+#include "utils/tests/utils_tests.h"
+
+DECLARE_UTILS_TEST("string_line_iterator - copy keeps a single char delimiter", string_line_iterator_copy_keeps_char_delimiter, "[a,b,c]");
+DECLARE_UTILS_TEST("string_line_range - copy keeps a single char delimiter", string_line_range_copy_keeps_char_delimiter, "[a,b,c]");
+DECLARE_UTILS_TEST("string_line_range - copy inside a view pipeline", string_line_range_copy_in_view_pipeline, "[1,2,3]");
\ No newline at end of file
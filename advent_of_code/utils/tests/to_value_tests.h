@@ -0,0 +1,14 @@
+#pragma once
+
+#include "utils/tests/utils_tests.h"
+
+DECLARE_UTILS_TEST("to_values - every length from 1 to 20 digits", to_values_all_digit_counts, "ok");
+DECLARE_UTILS_TEST("to_values - uint64_t limits", to_values_uint64_limits, "[0,18446744073709551615]");
+DECLARE_UTILS_TEST("to_values - signed values", to_values_signed, "[-1,-12,3,-123456789,-9223372036854775808,9223372036854775807]");
+DECLARE_UTILS_TEST("to_values - int32_t limits", to_values_int32_limits, "[-2147483648,2147483647]");
+DECLARE_UTILS_TEST("to_values - value ending at the end of the buffer", to_values_ends_at_buffer_end, "[7,123,123456789012]");
+DECLARE_UTILS_TEST("to_values - view ending before more digits", to_values_view_ends_mid_number, "[12,34]");
+DECLARE_UTILS_TEST("to_values - separators", to_values_separators, "[3,5,10,14,7]");
+DECLARE_UTILS_TEST("to_values - sign unless it is a separator", to_values_sign_or_separator, "[3,-5,3,5]");
+DECLARE_UTILS_TEST("to_values - runs of whitespace and separators", to_values_separator_runs, "[1,2,3]");
+DECLARE_UTILS_TEST("to_values - bad input is rejected", to_values_rejects_bad_input, "[rejected,rejected,rejected,rejected,rejected,rejected]");
\ No newline at end of file
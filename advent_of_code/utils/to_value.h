@@ -4,6 +4,13 @@
 #include <string_view>
 #include <cassert>
 #include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <vector>
 
 #include "trim_string.h"
 #include "advent/advent_utils.h"
@@ -64,4 +71,133 @@ namespace utils
 		AdventCheckMsg(result.ptr == last,"Could not convert string to value: " , sv);
 		return value;
 	}
+
+	namespace to_values_internal
+	{
+		inline bool is_digit(char c) noexcept
+		{
+			return static_cast<unsigned char>(c - '0') < 10u;
+		}
+
+		// Converts exactly eight ASCII digits, loaded little-endian so the first digit is in the low byte, a whole word at a time.
+		inline uint64_t parse_eight_digits(uint64_t word) noexcept
+		{
+			constexpr uint64_t mask = 0x000000FF000000FF;
+			constexpr uint64_t mul1 = 100 + (1000000ULL << 32);
+			constexpr uint64_t mul2 = 1 + (10000ULL << 32);
+			word = (word * 10) + (word >> 8);
+			return (((word & mask) * mul1) + (((word >> 16) & mask) * mul2)) >> 32;
+		}
+
+		// Converts 1-8 digits. The digits are shifted to the top of the word, so the gap below becomes leading zeros
+		// and whatever followed them in memory falls off the end.
+		inline uint64_t parse_up_to_eight_digits(const char* digits, std::size_t num_digits, std::size_t num_readable) noexcept
+		{
+			uint64_t word = 0;
+			std::memcpy(&word, digits, std::min<std::size_t>(8, num_readable));
+			word -= 0x3030303030303030;
+			word <<= 8 * (8 - num_digits);
+			return parse_eight_digits(word);
+		}
+
+		template <std::integral T>
+		T parse_digits(const char* digits, std::size_t num_digits, std::size_t num_readable, bool is_negative)
+		{
+			// Anything too long for two words, or on a big-endian machine, goes the slow way.
+			if (num_digits > 16 || std::endian::native != std::endian::little)
+			{
+				// A '-' is always right before the digits, and from_chars wants it there.
+				const char* first = is_negative ? digits - 1 : digits;
+				T value{};
+				const std::from_chars_result result = std::from_chars(first, digits + num_digits, value);
+				AdventCheckMsg(result.ec == std::errc{}, "Could not convert string to value: '", std::string_view{ first, digits + num_digits }, '\'');
+				return value;
+			}
+
+			uint64_t magnitude = 0;
+			if (num_digits > 8)
+			{
+				const std::size_t num_high = num_digits - 8;
+				magnitude = parse_up_to_eight_digits(digits, num_high, num_readable) * 100000000ULL
+					+ parse_up_to_eight_digits(digits + num_high, 8, num_readable - num_high);
+			}
+			else
+			{
+				magnitude = parse_up_to_eight_digits(digits, num_digits, num_readable);
+			}
+
+			using Unsigned = std::make_unsigned_t<T>;
+			const uint64_t limit = static_cast<uint64_t>(std::numeric_limits<T>::max()) + (is_negative ? 1u : 0u);
+			AdventCheckMsg(magnitude <= limit, "Value out of range: '", std::string_view{ digits, num_digits }, '\'');
+			const Unsigned as_unsigned = static_cast<Unsigned>(magnitude);
+			return static_cast<T>(is_negative ? Unsigned{ 0 } - as_unsigned : as_unsigned);
+		}
+	}
+
+	// Parses every integer in input, in order, onto the end of out.
+	// Integers may be separated by any run of whitespace or of the characters in separators, so "1,2\n3,4" with separators ","
+	// gives 1,2,3,4. For signed types a leading '-' or '+' is a sign unless it's one of the separators, so day 5's "3-5" works with "-".
+	// Validation is a separate table-driven pass over the whole input up front, which keeps the conversion loop
+	// free to turn up to eight digits at a time into a number with a couple of multiplies.
+	template <std::integral T>
+	inline void to_values(std::string_view input, std::string_view separators, std::vector<T>& out)
+	{
+		using to_values_internal::is_digit;
+		constexpr bool allow_sign = std::is_signed_v<T>;
+		auto is_sign = [&separators](char c)
+			{
+				return allow_sign && (c == '-' || c == '+') && separators.find(c) == std::string_view::npos;
+			};
+
+		std::array<bool, 256> is_allowed{};
+		for (char c : std::string_view{ "0123456789 \t\r\n" })
+		{
+			is_allowed[static_cast<unsigned char>(c)] = true;
+		}
+		for (char c : std::string_view{ "+-" })
+		{
+			is_allowed[static_cast<unsigned char>(c)] = is_sign(c);
+		}
+		for (char c : separators)
+		{
+			is_allowed[static_cast<unsigned char>(c)] = true;
+		}
+		const bool all_allowed = stdr::all_of(input, [&is_allowed](char c) { return is_allowed[static_cast<unsigned char>(c)]; });
+		AdventCheckMsg(all_allowed, "Could not convert string to values: '", input, '\'');
+
+		const char* data = input.data();
+		const std::size_t size = input.size();
+		std::size_t pos = 0;
+		while (true)
+		{
+			while (pos < size && !is_digit(data[pos]) && !is_sign(data[pos]))
+			{
+				++pos;
+			}
+			if (pos == size) break;
+
+			bool is_negative = false;
+			if (is_sign(data[pos]))
+			{
+				is_negative = data[pos] == '-';
+				++pos;
+				AdventCheckMsg(pos < size && is_digit(data[pos]), "Sign without a number in: '", input, '\'');
+			}
+
+			const std::size_t start = pos;
+			while (pos < size && is_digit(data[pos]))
+			{
+				++pos;
+			}
+			out.push_back(to_values_internal::parse_digits<T>(data + start, pos - start, size - start, is_negative));
+		}
+	}
+
+	template <std::integral T>
+	inline std::vector<T> to_values(std::string_view input, std::string_view separators)
+	{
+		std::vector<T> result;
+		to_values(input, separators, result);
+		return result;
+	}
 }
\ No newline at end of file